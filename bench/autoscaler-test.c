@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+/* Feeds synthetic traces to the percentile autoscaler, one sample per
+ * interval of simulated time. Graphs up to AUTOSCALER_RING_SIZE columns wide
+ * use the exact path (quickselect), which is compared with a sorted
+ * reference. Wider graphs use the sketch, which is only known within 10%. */
+
+#include <config.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/autoscaler.h"
+#include "common/collector.h"
+#include "common/multiload-config.h"
+
+// same constants as autoscaler.c
+#define HEADROOM 1.2f
+#define HYSTERESIS 0.7f
+#define SKETCH_ERROR 1.1
+
+#define INTERVAL 1000
+
+typedef struct {
+	MultiloadCollector *c;
+	AutoScaler s;
+	gint64 now;
+} Trace;
+
+
+static void
+trace_init (Trace *t, guint width, guint percentile)
+{
+	t->c = multiload_collector_new(GRAPH_NETLOAD);
+	t->c->interval = INTERVAL;
+	t->c->width = width;
+	t->c->autoscaler_percentile = percentile;
+
+	memset(&t->s, 0, sizeof(t->s));
+	autoscaler_set_enabled(&t->s, TRUE);
+	autoscaler_set_min(&t->s, 1);
+	t->now = G_USEC_PER_SEC;
+}
+
+static void
+trace_free (Trace *t)
+{
+	multiload_collector_free(t->c);
+}
+
+/* Feeds count samples of given value, returns max after last one */
+static int
+trace_feed (Trace *t, int value, guint count)
+{
+	int max = t->s.max;
+
+	while (count-- > 0) {
+		max = autoscaler_get_max_at(&t->s, t->c, value, t->now);
+		t->now += INTERVAL * 1000;
+	}
+	return max;
+}
+
+static int
+compare_int (gconstpointer a, gconstpointer b)
+{
+	return *(const int*)a - *(const int*)b;
+}
+
+/* Percentile of the last n values of trace, by sorting */
+static int
+reference_percentile (const int *trace, guint len, guint n, guint percentile)
+{
+	int v[AUTOSCALER_RING_SIZE];
+	guint k;
+
+	n = MIN(n, len);
+	memcpy(v, trace + len - n, n * sizeof(int));
+	qsort(v, n, sizeof(int), compare_int);
+
+	k = (n * percentile + 99) / 100;
+	return v[CLAMP(k, 1, n) - 1];
+}
+
+/* Next max according to the documented policy: grow right away, shrink only
+ * below the hysteresis threshold */
+static int
+reference_max (int max, int percentile_value)
+{
+	int target = MIN(percentile_value * HEADROOM, G_MAXINT);
+
+	if (target > max || target < max * HYSTERESIS)
+		max = target;
+	return MAX(max, 1);
+}
+
+static void
+assert_sketch_max (int max, int value)
+{
+	g_assert_cmpint(max, >=, (int)(value * HEADROOM));
+	g_assert_cmpint(max, <=, (int)(value * SKETCH_ERROR * HEADROOM) + 1);
+}
+
+
+static void
+test_ring_step (void)
+{
+	Trace t;
+	trace_init(&t, 100, 95);
+
+	g_assert_cmpint(trace_feed(&t, 1000, 100), ==, 1200);
+
+	// p95 of 100 samples moves once 6 of them are higher
+	g_assert_cmpint(trace_feed(&t, 5000, 5), ==, 1200);
+	g_assert_cmpint(trace_feed(&t, 5000, 1), ==, 6000);
+	g_assert_cmpint(trace_feed(&t, 5000, 94), ==, 6000);
+
+	trace_free(&t);
+}
+
+static void
+test_ring_spike (void)
+{
+	Trace t95, t99;
+	trace_init(&t95, 100, 95);
+	trace_init(&t99, 100, 99);
+
+	trace_feed(&t95, 1000, 100);
+	trace_feed(&t99, 1000, 100);
+
+	g_assert_cmpint(trace_feed(&t95, 100000, 1), ==, 1200);
+	g_assert_cmpint(trace_feed(&t99, 100000, 1), ==, 1200);
+
+	// two spikes in 100 samples are above p99
+	g_assert_cmpint(trace_feed(&t95, 100000, 1), ==, 1200);
+	g_assert_cmpint(trace_feed(&t99, 100000, 1), ==, 120000);
+
+	trace_free(&t95);
+	trace_free(&t99);
+}
+
+static void
+test_ring_hysteresis (void)
+{
+	Trace t;
+	trace_init(&t, 100, 95);
+
+	trace_feed(&t, 5000, 100);
+	g_assert_cmpint(t.s.max, ==, 6000);
+
+	// 4800 is above 70% of 6000: kept
+	g_assert_cmpint(trace_feed(&t, 4000, 100), ==, 6000);
+
+	// 3600 is below, max drops as soon as p95 reaches it
+	g_assert_cmpint(trace_feed(&t, 3000, 94), ==, 6000);
+	g_assert_cmpint(trace_feed(&t, 3000, 1), ==, 3600);
+
+	trace_free(&t);
+}
+
+static void
+test_ring_ramp (void)
+{
+	int trace[200];
+	guint i, p;
+	int max;
+
+	for (p = 95; p <= 99; p += 4) {
+		Trace t;
+		trace_init(&t, 100, p);
+
+		for (i = 0, max = 0; i < G_N_ELEMENTS(trace); i++) {
+			trace[i] = (i < 100) ? (i + 1) * 10 : (200 - i) * 10; // up, then down
+			max = reference_max(max, reference_percentile(trace, i + 1, 100, p));
+			g_assert_cmpint(trace_feed(&t, trace[i], 1), ==, max);
+		}
+
+		trace_free(&t);
+	}
+}
+
+/* Random traces over several widths, exact path against sorted reference */
+static void
+test_ring_random (void)
+{
+	static const guint widths[] = { 1, 10, 50, 128 };
+	int trace[1000];
+	GRand *rand = g_rand_new_with_seed(42);
+	guint i, w, p;
+	int max;
+
+	for (w = 0; w < G_N_ELEMENTS(widths); w++) {
+		for (p = 95; p <= 99; p += 4) {
+			Trace t;
+			trace_init(&t, widths[w], p);
+
+			for (i = 0, max = 0; i < G_N_ELEMENTS(trace); i++) {
+				// bursts over a noisy baseline
+				trace[i] = g_rand_int_range(rand, 0, 1000);
+				if (g_rand_int_range(rand, 0, 20) == 0)
+					trace[i] *= 50;
+
+				max = reference_max(max, reference_percentile(trace, i + 1, widths[w], p));
+				g_assert_cmpint(trace_feed(&t, trace[i], 1), ==, max);
+			}
+
+			trace_free(&t);
+		}
+	}
+
+	g_rand_free(rand);
+}
+
+static void
+test_sketch_step (void)
+{
+	Trace t;
+	trace_init(&t, 400, 95);
+
+	assert_sketch_max(trace_feed(&t, 1000, 400), 1000);
+	assert_sketch_max(trace_feed(&t, 5000, 400), 5000);
+
+	trace_free(&t);
+}
+
+static void
+test_sketch_spike (void)
+{
+	Trace t;
+	int max;
+	trace_init(&t, 400, 99);
+
+	max = trace_feed(&t, 1000, 400);
+	assert_sketch_max(max, 1000);
+	g_assert_cmpint(trace_feed(&t, 100000, 1), ==, max);
+
+	trace_free(&t);
+}
+
+static void
+test_sketch_hysteresis (void)
+{
+	Trace t;
+	int max;
+	trace_init(&t, 400, 95);
+
+	max = trace_feed(&t, 5000, 400);
+
+	// at most 4400 * 1.2 against at least 0.7 * 6000: kept
+	g_assert_cmpint(trace_feed(&t, 4000, 400), ==, max);
+
+	// old samples leave the sketch within a window
+	assert_sketch_max(trace_feed(&t, 2000, 400), 2000);
+
+	trace_free(&t);
+}
+
+/* Sketch covers between half and full window, so p95 is somewhere between
+ * p95 of the whole window and the last value */
+static void
+test_sketch_ramp (void)
+{
+	Trace t;
+	int trace[400];
+	guint i;
+	int max;
+	trace_init(&t, 400, 95);
+
+	for (i = 0; i < G_N_ELEMENTS(trace); i++) {
+		trace[i] = (i + 1) * 100;
+		max = trace_feed(&t, trace[i], 1);
+	}
+
+	g_assert_cmpint(max, >=, (int)(trace[G_N_ELEMENTS(trace) * 95 / 100 - 1] * HEADROOM));
+	g_assert_cmpint(max, <=, (int)(trace[G_N_ELEMENTS(trace) - 1] * SKETCH_ERROR * HEADROOM) + 1);
+
+	trace_free(&t);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+	g_test_init(&argc, &argv, NULL);
+	multiload_config_init();
+
+	g_test_add_func("/autoscaler/ring/step", test_ring_step);
+	g_test_add_func("/autoscaler/ring/spike", test_ring_spike);
+	g_test_add_func("/autoscaler/ring/hysteresis", test_ring_hysteresis);
+	g_test_add_func("/autoscaler/ring/ramp", test_ring_ramp);
+	g_test_add_func("/autoscaler/ring/random", test_ring_random);
+	g_test_add_func("/autoscaler/sketch/step", test_sketch_step);
+	g_test_add_func("/autoscaler/sketch/spike", test_sketch_spike);
+	g_test_add_func("/autoscaler/sketch/hysteresis", test_sketch_hysteresis);
+	g_test_add_func("/autoscaler/sketch/ramp", test_sketch_ramp);
+
+	return g_test_run();
+}
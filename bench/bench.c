@@ -0,0 +1,449 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+/* Microbenchmarks of sampling and rendering hot paths. Each case is run in
+ * batches for a fixed time, the fastest batch gives the reported time per
+ * operation. Output is tab separated, so it can be saved and used as baseline
+ * of a later run:
+ *
+ *   multiload-ng-bench > baseline.tsv
+ *   multiload-ng-bench --baseline baseline.tsv
+ *
+ * Collectors read the live system, unless MULTILOAD_SYSROOT points to a
+ * recorded frame (see record-fixture.sh). */
+
+#include <config.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/info-file.h"
+#include "common/load-graph.h"
+#include "common/multiload.h"
+#include "common/multiload-config.h"
+#include "common/util-gtk.h"
+
+
+typedef void (*BenchFunc) (gpointer user_data);
+
+typedef struct {
+	LoadGraph *g;
+	GRand *rand;
+	MultiloadPixbufPool pool;
+	gint values[MAX_COLORS*MAX_STRIPS];
+} BenchGraph;
+
+
+static gint opt_time = 200;
+static gint opt_runs = 5;
+static gchar *opt_baseline = NULL;
+static gdouble opt_threshold = 10;
+static gchar *opt_filter = NULL;
+
+static GOptionEntry bench_entries[] = {
+	{ "time",		't', 0, G_OPTION_ARG_INT,		&opt_time,		"Milliseconds spent on each case (default: 200)", "MS" },
+	{ "runs",		'r', 0, G_OPTION_ARG_INT,		&opt_runs,		"Batches per case, the fastest one is reported (default: 5)", "N" },
+	{ "baseline",	'b', 0, G_OPTION_ARG_FILENAME,	&opt_baseline,	"Compare with the output of a previous run", "FILE" },
+	{ "threshold",	0,	 0, G_OPTION_ARG_DOUBLE,	&opt_threshold,	"Slowdown percentage reported as regression (default: 10)", "PCT" },
+	{ "filter",		'f', 0, G_OPTION_ARG_STRING,	&opt_filter,	"Only run cases whose name contains this string", "STRING" },
+	{ NULL }
+};
+
+static GHashTable *baseline = NULL;
+static guint regressions = 0;
+
+
+static inline guint64
+bench_now_ns ()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (guint64)ts.tv_sec * G_GUINT64_CONSTANT(1000000000) + ts.tv_nsec;
+}
+
+/* Baseline is a previous output: "name<TAB>ns_per_op" lines, other columns
+ * and comments are ignored */
+static GHashTable*
+bench_load_baseline (const gchar *path)
+{
+	gchar *contents, **lines, **fields;
+	GHashTable *table;
+	GError *error = NULL;
+	guint i;
+
+	if (!g_file_get_contents(path, &contents, NULL, &error)) {
+		g_printerr("Unable to load baseline: %s\n", error->message);
+		g_error_free(error);
+		exit(1);
+	}
+
+	table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	lines = g_strsplit(contents, "\n", -1);
+	for (i=0; lines[i] != NULL; i++) {
+		if (lines[i][0] == '#' || lines[i][0] == '\0')
+			continue;
+
+		fields = g_strsplit(lines[i], "\t", 3);
+		if (fields[0] != NULL && fields[1] != NULL) {
+			gdouble *ns = g_new(gdouble, 1);
+			*ns = g_ascii_strtod(fields[1], NULL);
+			g_hash_table_insert(table, g_strdup(fields[0]), ns);
+		}
+		g_strfreev(fields);
+	}
+
+	g_strfreev(lines);
+	g_free(contents);
+	return table;
+}
+
+static void
+bench_run (const gchar *name, BenchFunc func, gpointer user_data)
+{
+	guint64 iterations, start, elapsed, batch_ns;
+	gdouble ns, best = G_MAXDOUBLE;
+	gchar buf[G_ASCII_DTOSTR_BUF_SIZE];
+	gint r;
+
+	if (opt_filter != NULL && strstr(name, opt_filter) == NULL)
+		return;
+
+	batch_ns = (guint64)MAX(opt_time, 1) * 1000000 / MAX(opt_runs, 1);
+
+	// calibration: find how many iterations fill a batch
+	for (iterations = 1; ; iterations *= 2) {
+		start = bench_now_ns();
+		for (guint64 i = 0; i < iterations; i++)
+			func(user_data);
+		elapsed = bench_now_ns() - start;
+		if (elapsed >= batch_ns / 4 || iterations >= G_GUINT64_CONSTANT(1) << 30)
+			break;
+	}
+	iterations = MAX(1, iterations * batch_ns / MAX(elapsed, 1));
+
+	for (r = 0; r < MAX(opt_runs, 1); r++) {
+		start = bench_now_ns();
+		for (guint64 i = 0; i < iterations; i++)
+			func(user_data);
+		ns = (gdouble)(bench_now_ns() - start) / iterations;
+		best = MIN(best, ns);
+	}
+
+	printf("%s\t%s", name, g_ascii_formatd(buf, sizeof(buf), "%.1f", best));
+
+	if (baseline != NULL) {
+		gdouble *base = g_hash_table_lookup(baseline, name);
+		if (base != NULL && *base > 0) {
+			gdouble change = (best - *base) * 100 / *base;
+			printf("\t%s", g_ascii_formatd(buf, sizeof(buf), "%.1f", *base));
+			printf("\t%s%%", g_ascii_formatd(buf, sizeof(buf), "%+.1f", change));
+			if (change > opt_threshold) {
+				printf("\tREGRESSION");
+				regressions++;
+			}
+		} else {
+			printf("\t-\t-");
+		}
+	}
+
+	printf("\n");
+	fflush(stdout);
+}
+
+
+static void
+bench_get_data (BenchGraph *b)
+{
+	MultiloadCollector *c = b->g->collector;
+	graph_types[c->id].get_data(MULTILOAD_COLLECTOR_DATA_ONE, b->values, c, c->data, FALSE);
+}
+
+/* Same work as a timer tick: graph scrolls by one column, then it is drawn */
+static void
+bench_draw (BenchGraph *b)
+{
+	LoadGraph *g = b->g;
+	guint num_data = multiload_config_get_num_data(g->id);
+	gint left = MULTILOAD_COLLECTOR_DATA_ONE;
+	gint values[MAX_COLORS*MAX_STRIPS] = { 0 };
+	gfloat scales[MAX_STRIPS] = { 1 };
+	guint j;
+
+	for (j = 0; j < num_data; j++) {
+		values[j] = g_rand_int_range(b->rand, 0, left / 2 + 1);
+		left -= values[j];
+	}
+
+	load_graph_push(g, values, scales);
+	load_graph_render(g);
+}
+
+/* Values above the scale of their column must survive when the scale grows:
+ * 3x the old scale, drawn after the scale becomes 4x, is 3/4 of the graph.
+ * Returns FALSE if heights do not match. */
+static gboolean
+bench_check_rescale (LoadGraph *g)
+{
+	gint values[MAX_COLORS*MAX_STRIPS] = { 0 };
+	gfloat scales[MAX_STRIPS] = { 0 };
+	guint h, expected[2];
+
+	values[0] = 3 * MULTILOAD_COLLECTOR_DATA_ONE;
+	scales[0] = 1;
+	load_graph_push(g, values, scales);
+
+	values[0] = MULTILOAD_COLLECTOR_DATA_ONE / 4;
+	scales[0] = 4;
+	load_graph_push(g, values, scales);
+	load_graph_render(g);
+
+	h = g->display_height;
+	expected[0] = rint(h * 0.25);
+	expected[1] = rint(h * 0.75);
+	if (g->data->pixel[0] != expected[0] || g->data->pixel[1] != expected[1]) {
+		g_printerr("rescale: heights %u,%u, expected %u,%u\n", g->data->pixel[0], g->data->pixel[1], expected[0], expected[1]);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void
+bench_pixbuf (BenchGraph *b)
+{
+	GdkPixbuf *pixbuf = cairo_surface_to_gdk_pixbuf(b->g->surface, b->g->draw_width, b->g->draw_height);
+	g_object_unref(pixbuf);
+}
+
+static void
+bench_pixbuf_pool (BenchGraph *b)
+{
+	GdkPixbuf *pixbuf = multiload_pixbuf_pool_next(&b->pool, b->g->draw_width, b->g->draw_height);
+	cairo_surface_copy_to_gdk_pixbuf(b->g->surface, pixbuf);
+}
+
+/* Configure event with unchanged size, should not touch any buffer */
+static void
+bench_configure (BenchGraph *b)
+{
+	load_graph_set_draw_size(b->g, b->g->draw_width, b->g->draw_height);
+}
+
+static void
+bench_tooltip (BenchGraph *b)
+{
+	multiload_tooltip_update(b->g);
+}
+
+static void
+bench_info_file_read_string_s (gpointer user_data)
+{
+	gchar buf[128];
+	info_file_read_string_s("/proc/loadavg", buf, sizeof(buf), NULL);
+}
+
+static void
+bench_info_file_read_string (gpointer user_data)
+{
+	gchar *buf;
+	if (info_file_read_string("/proc/stat", &buf, NULL))
+		g_free(buf);
+}
+
+static void
+bench_info_file_read_uint64 (gpointer user_data)
+{
+	guint64 v;
+	info_file_read_uint64("/proc/sys/kernel/pid_max", &v);
+}
+
+static void
+bench_info_file_read_double (gpointer user_data)
+{
+	gdouble v;
+	info_file_read_double("/proc/uptime", &v, 1);
+}
+
+static void
+bench_info_file_read_key_uint64 (gpointer user_data)
+{
+	guint64 v;
+	info_file_read_key_uint64("/proc/meminfo", "MemAvailable", &v);
+}
+
+static void
+bench_info_file_read_key_string_s (gpointer user_data)
+{
+	gchar buf[128];
+	info_file_read_key_string_s("/proc/cpuinfo", "model name", buf, sizeof(buf), NULL);
+}
+
+static void
+bench_info_file_read_keys (gpointer user_data)
+{
+	guint64 kb_total, kb_free, kb_available, kb_buffers, kb_cached;
+	const InfoFileMappingEntry table[] = {
+		{ "MemTotal",		'u',	&kb_total },
+		{ "MemFree",		'u',	&kb_free },
+		{ "MemAvailable",	'u',	&kb_available },
+		{ "Buffers",		'u',	&kb_buffers },
+		{ "Cached",			'u',	&kb_cached }
+	};
+	info_file_read_keys("/proc/meminfo", table, G_N_ELEMENTS(table));
+}
+
+static void
+bench_info_file_has_contents (gpointer user_data)
+{
+	info_file_has_contents("/proc/sys/kernel/ostype", "Linux", TRUE);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+	static const guint sizes[][2] = { { 40, 24 }, { 100, 48 }, { 400, 200 } };
+	static const guint draw_graphs[] = { GRAPH_LOADAVG, GRAPH_DISKLOAD, GRAPH_NETLOAD, GRAPH_CPULOAD }; // 1 to 4 series
+
+	GOptionContext *context;
+	GError *error = NULL;
+	MultiloadPlugin *ma;
+	BenchGraph b;
+	gboolean have_display;
+	gchar name[64];
+	guint i, s;
+	guint64 allocs;
+	gboolean failed = FALSE;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Microbenchmarks of multiload-ng sampling and rendering");
+	g_option_context_add_main_entries (context, bench_entries, NULL);
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_printerr ("%s\n", error->message);
+		g_error_free (error);
+		return 1;
+	}
+	g_option_context_free (context);
+
+	if (opt_baseline != NULL)
+		baseline = bench_load_baseline(opt_baseline);
+
+	// tooltips need widgets, everything else works without a display
+	have_display = gtk_init_check(&argc, &argv);
+
+	ma = multiload_new_full(TRUE);
+	multiload_defaults(ma);
+
+	memset(&b, 0, sizeof(b));
+	b.rand = g_rand_new_with_seed(42);
+
+	if (baseline != NULL)
+		printf("# case\tns_per_op\tbaseline_ns\tchange\n");
+	else
+		printf("# case\tns_per_op\n");
+
+	// data collection (first sample is taken outside, it only stores initial values)
+	for (i = 0; i < GRAPH_MAX; i++) {
+		if (i == GRAPH_PARAMETRIC) // runs an external command
+			continue;
+
+		b.g = ma->graphs[i];
+		multiload_collector_sample(b.g->collector, b.values);
+		g_snprintf(name, sizeof(name), "get_data/%s", graph_types[i].name);
+		bench_run(name, (BenchFunc)bench_get_data, &b);
+	}
+
+	// drawing, by size and number of series
+	for (i = 0; i < G_N_ELEMENTS(draw_graphs); i++) {
+		b.g = ma->graphs[draw_graphs[i]];
+		for (s = 0; s < G_N_ELEMENTS(sizes); s++) {
+			load_graph_set_draw_size(b.g, sizes[s][0], sizes[s][1]);
+			if (!bench_check_rescale(b.g))
+				failed = TRUE;
+			for (guint k = 0; k < b.g->draw_width; k++)
+				bench_draw(&b);
+
+			g_snprintf(name, sizeof(name), "draw/%ux%u/%useries", sizes[s][0], sizes[s][1], multiload_config_get_num_data(b.g->id));
+			bench_run(name, (BenchFunc)bench_draw, &b);
+
+			if (i == 0) {
+				g_snprintf(name, sizeof(name), "pixbuf/%ux%u", sizes[s][0], sizes[s][1]);
+				bench_run(name, (BenchFunc)bench_pixbuf, &b);
+				g_snprintf(name, sizeof(name), "pixbuf_pool/%ux%u", sizes[s][0], sizes[s][1]);
+				bench_run(name, (BenchFunc)bench_pixbuf_pool, &b);
+				multiload_pixbuf_pool_clear(&b.pool);
+
+				allocs = b.g->profile.allocs;
+				g_snprintf(name, sizeof(name), "configure/%ux%u", sizes[s][0], sizes[s][1]);
+				bench_run(name, (BenchFunc)bench_configure, &b);
+				if (b.g->profile.allocs != allocs)
+					g_printerr("%s: %"G_GUINT64_FORMAT" unexpected allocations\n", name, b.g->profile.allocs - allocs);
+			}
+		}
+		load_graph_unalloc(b.g);
+	}
+
+	// tooltips, with data of the last sample
+	if (have_display) {
+		for (i = 0; i < GRAPH_MAX; i++) {
+			if (i == GRAPH_PARAMETRIC)
+				continue;
+
+			b.g = ma->graphs[i];
+			b.g->disp = g_object_ref_sink(gtk_drawing_area_new());
+			b.g->config->tooltip_style = MULTILOAD_TOOLTIP_STYLE_DETAILED;
+			g_snprintf(name, sizeof(name), "tooltip/%s", graph_types[i].name);
+			bench_run(name, (BenchFunc)bench_tooltip, &b);
+			gtk_widget_destroy(b.g->disp);
+			g_object_unref(b.g->disp);
+			b.g->disp = NULL;
+		}
+	} else {
+		printf("# tooltip cases skipped: no display\n");
+	}
+
+	// parsers
+	bench_run("info_file/read_string_s", bench_info_file_read_string_s, NULL);
+	bench_run("info_file/read_string", bench_info_file_read_string, NULL);
+	bench_run("info_file/read_uint64", bench_info_file_read_uint64, NULL);
+	bench_run("info_file/read_double", bench_info_file_read_double, NULL);
+	bench_run("info_file/read_key_uint64", bench_info_file_read_key_uint64, NULL);
+	bench_run("info_file/read_key_string_s", bench_info_file_read_key_string_s, NULL);
+	bench_run("info_file/read_keys", bench_info_file_read_keys, NULL);
+	bench_run("info_file/has_contents", bench_info_file_has_contents, NULL);
+
+	g_rand_free(b.rand);
+	multiload_free(ma);
+
+	if (baseline != NULL) {
+		g_hash_table_destroy(baseline);
+		if (regressions > 0) {
+			g_printerr("%u cases slower than baseline by more than %.1f%%\n", regressions, opt_threshold);
+			return 2;
+		}
+	}
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+#!/bin/sh
+
+# Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+#
+# This file is part of multiload-ng.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+
+# Records the system files read by collectors, one frame per sample, so that
+# multiload-ng-replay can run collectors against the same data every time.
+#
+# Layout of the fixture directory:
+#   info       sampling parameters (GKeyFile)
+#   0000/...   first frame, a copy of every file under its absolute path
+#   0001/...   and so on
+
+samples=30
+interval=1000
+
+usage() {
+	echo "Usage: $0 [-n samples] [-i interval_ms] DIRECTORY" >&2
+	exit 1
+}
+
+while getopts "n:i:h" opt; do
+	case $opt in
+		n) samples=$OPTARG ;;
+		i) interval=$OPTARG ;;
+		*) usage ;;
+	esac
+done
+shift $((OPTIND-1))
+
+[ $# -eq 1 ] || usage
+dest=$1
+
+if [ -e "$dest" ]; then
+	echo "$dest already exists" >&2
+	exit 1
+fi
+mkdir -p "$dest" || exit 1
+
+printf '[fixture]\ninterval=%s\nsamples=%s\n' "$interval" "$samples" > "$dest/info"
+
+# copy a regular, readable file preserving its absolute path
+save() {
+	[ -f "$1" ] && [ -r "$1" ] || return 0
+	mkdir -p "$frame$(dirname "$1")"
+	cat "$1" > "$frame$1" 2>/dev/null
+}
+
+# symlinks are recreated, some collectors look at their target
+save_link() {
+	[ -L "$1" ] || return 0
+	mkdir -p "$frame$(dirname "$1")"
+	ln -sfn "$(readlink "$1")" "$frame$1"
+}
+
+record_frame() {
+	for f in stat meminfo vmstat loadavg uptime cpuinfo softirqs partitions net/dev net/snmp pressure/*; do
+		save "/proc/$f"
+	done
+
+	save /sys/devices/system/cpu/cpu0/cpufreq/scaling_governor
+	for f in /sys/devices/system/cpu/cpu*/cpufreq/scaling_cur_freq; do
+		save "$f"
+	done
+
+	for f in /sys/block/*/stat /sys/block/*/*/stat /sys/block/*/mm_stat; do
+		save "$f"
+	done
+	for f in /sys/dev/block/*; do
+		save_link "$f"
+	done
+
+	for d in /sys/class/net/*; do
+		for f in address flags ifindex speed type; do
+			save "$d/$f"
+		done
+	done
+
+	for f in /sys/class/hwmon/*/* /sys/class/hwmon/*/device/* /sys/class/thermal/thermal_zone*/*; do
+		save "$f"
+	done
+	for f in /sys/class/power_supply/*/*; do
+		save "$f"
+	done
+
+	for f in /sys/kernel/debug/zswap/*; do
+		save "$f"
+	done
+
+	mkdir -p "$frame/etc"
+	cat /proc/self/mounts > "$frame/etc/mtab"
+}
+
+i=0
+while [ $i -lt "$samples" ]; do
+	frame=$(printf '%s/%04d' "$dest" $i)
+	mkdir -p "$frame"
+	record_frame
+	i=$((i+1))
+
+	[ $i -lt "$samples" ] && sleep "$(awk "BEGIN { print $interval / 1000 }")"
+done
+
+echo "Recorded $samples frames in $dest"
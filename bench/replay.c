@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+/* Runs collectors against a fixture recorded by record-fixture.sh, so that
+ * changes to data collection can be timed on the same input every time.
+ *
+ * Frames are loaded in memory, then written one at a time into a scratch
+ * sysroot. Files are rewritten in place (same inode), so that descriptors
+ * kept open by collectors see new contents like they would on procfs. Only
+ * the time spent in multiload_collector_sample is measured. */
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "common/collector.h"
+#include "common/info-file.h"
+#include "common/multiload-config.h"
+#include "common/proc-stat.h"
+
+
+typedef struct {
+	gchar *path;		// absolute path on the recorded system
+	gchar *contents;	// symlink target, when is_link is set
+	gsize length;
+	gboolean is_link;
+} FixtureFile;
+
+typedef struct {
+	GPtrArray *files;
+} FixtureFrame;
+
+typedef struct {
+	guint64 samples;
+	guint64 total_ns;
+	guint64 max_ns;
+} ReplayStats;
+
+
+static gint opt_repeat = 1;
+static gint opt_width = 100;
+static gchar *opt_graphs = NULL;
+
+static GOptionEntry replay_entries[] = {
+	{ "repeat",	'r', 0, G_OPTION_ARG_INT,		&opt_repeat,	"Replay fixture this many times (default: 1)", "N" },
+	{ "width",	'w', 0, G_OPTION_ARG_INT,		&opt_width,		"Graph width seen by autoscalers (default: 100)", "PIXELS" },
+	{ "graphs",	'g', 0, G_OPTION_ARG_STRING,	&opt_graphs,	"Comma separated list of graphs to run (default: all)", "LIST" },
+	{ NULL }
+};
+
+
+static void
+fixture_file_free (FixtureFile *file)
+{
+	g_free(file->path);
+	g_free(file->contents);
+	g_free(file);
+}
+
+static void
+fixture_frame_free (FixtureFrame *frame)
+{
+	g_ptr_array_free(frame->files, TRUE);
+	g_free(frame);
+}
+
+static void
+fixture_frame_load_dir (FixtureFrame *frame, const gchar *root, const gchar *relative)
+{
+	const gchar *name;
+	gchar *dirpath = g_build_filename(root, relative, NULL);
+	GDir *dir = g_dir_open(dirpath, 0, NULL);
+
+	if (dir == NULL) {
+		g_free(dirpath);
+		return;
+	}
+
+	while ((name = g_dir_read_name(dir)) != NULL) {
+		gchar *child = g_build_filename(relative, name, NULL);
+		gchar *child_path = g_build_filename(dirpath, name, NULL);
+
+		if (g_file_test(child_path, G_FILE_TEST_IS_SYMLINK)) {
+			FixtureFile *file = g_new0(FixtureFile, 1);
+			file->path = child;
+			file->contents = g_file_read_link(child_path, NULL);
+			file->is_link = TRUE;
+			g_ptr_array_add(frame->files, file);
+		} else if (g_file_test(child_path, G_FILE_TEST_IS_DIR)) {
+			fixture_frame_load_dir(frame, root, child);
+			g_free(child);
+		} else {
+			FixtureFile *file = g_new0(FixtureFile, 1);
+			file->path = child;
+			if (!g_file_get_contents(child_path, &file->contents, &file->length, NULL))
+				file->contents = g_strdup("");
+			g_ptr_array_add(frame->files, file);
+		}
+
+		g_free(child_path);
+	}
+
+	g_dir_close(dir);
+	g_free(dirpath);
+}
+
+static gboolean
+fixture_frame_write (FixtureFrame *frame, const gchar *sysroot)
+{
+	gchar path[PATH_MAX];
+	guint i;
+
+	for (i=0; i<frame->files->len; i++) {
+		FixtureFile *file = g_ptr_array_index(frame->files, i);
+		g_snprintf(path, sizeof(path), "%s%s", sysroot, file->path);
+
+		if (file->is_link) {
+			if (g_file_test(path, G_FILE_TEST_IS_SYMLINK))
+				continue;
+			gchar *dirname = g_path_get_dirname(path);
+			g_mkdir_with_parents(dirname, 0700);
+			g_free(dirname);
+			if (file->contents == NULL || symlink(file->contents, path) != 0)
+				g_printerr("Unable to create link '%s': %s\n", path, g_strerror(errno));
+			continue;
+		}
+
+		int fd = open(path, O_WRONLY | O_TRUNC | O_CLOEXEC);
+		if (fd < 0) {
+			gchar *dirname = g_path_get_dirname(path);
+			g_mkdir_with_parents(dirname, 0700);
+			g_free(dirname);
+			fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+		}
+		if (fd < 0) {
+			g_printerr("Unable to write '%s': %s\n", path, g_strerror(errno));
+			return FALSE;
+		}
+
+		gsize done = 0;
+		while (done < file->length) {
+			gssize n = write(fd, file->contents + done, file->length - done);
+			if (n < 0) {
+				if (errno == EINTR)
+					continue;
+				g_printerr("Unable to write '%s': %s\n", path, g_strerror(errno));
+				close(fd);
+				return FALSE;
+			}
+			done += n;
+		}
+		close(fd);
+	}
+
+	return TRUE;
+}
+
+static void
+remove_tree (const gchar *path)
+{
+	const gchar *name;
+	GDir *dir;
+
+	if (!g_file_test(path, G_FILE_TEST_IS_SYMLINK) && (dir = g_dir_open(path, 0, NULL)) != NULL) {
+		while ((name = g_dir_read_name(dir)) != NULL) {
+			gchar *child = g_build_filename(path, name, NULL);
+			remove_tree(child);
+			g_free(child);
+		}
+		g_dir_close(dir);
+		rmdir(path);
+	} else {
+		unlink(path);
+	}
+}
+
+static inline guint64
+replay_now_ns ()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (guint64)ts.tv_sec * G_GUINT64_CONSTANT(1000000000) + ts.tv_nsec;
+}
+
+static gboolean
+replay_graph_enabled (guint id)
+{
+	gchar **names;
+	gboolean found;
+	guint i;
+
+	// parametric graph runs a user command, it cannot be replayed
+	if (id == GRAPH_PARAMETRIC)
+		return FALSE;
+	if (opt_graphs == NULL)
+		return TRUE;
+
+	names = g_strsplit(opt_graphs, ",", -1);
+	found = FALSE;
+	for (i=0; names[i] != NULL; i++) {
+		if (strcmp(names[i], graph_types[id].name) == 0)
+			found = TRUE;
+	}
+	g_strfreev(names);
+	return found;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+	GOptionContext *context;
+	GError *error = NULL;
+	GKeyFile *info;
+	GPtrArray *frames;
+	MultiloadCollector *collectors[GRAPH_MAX];
+	ReplayStats stats[GRAPH_MAX];
+	gint values[MAX_COLORS*MAX_STRIPS];
+	gchar *info_path, *workdir;
+	gint interval;
+	guint i, f, r;
+
+	context = g_option_context_new ("FIXTURE");
+	g_option_context_set_summary (context, "Replay a recorded fixture through multiload-ng collectors and time them.\nFixtures are recorded with record-fixture.sh");
+	g_option_context_add_main_entries (context, replay_entries, NULL);
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_printerr ("%s\n", error->message);
+		g_error_free (error);
+		return 1;
+	}
+	g_option_context_free (context);
+
+	if (argc != 2) {
+		g_printerr ("Missing fixture directory, see --help\n");
+		return 1;
+	}
+
+	// parameters
+	info = g_key_file_new();
+	info_path = g_build_filename(argv[1], "info", NULL);
+	if (!g_key_file_load_from_file(info, info_path, G_KEY_FILE_NONE, &error)) {
+		g_printerr ("Unable to load '%s': %s\n", info_path, error->message);
+		g_error_free (error);
+		return 1;
+	}
+	interval = g_key_file_get_integer(info, "fixture", "interval", NULL);
+	if (interval <= 0)
+		interval = 1000;
+	g_key_file_free(info);
+	g_free(info_path);
+
+	// frames
+	frames = g_ptr_array_new_with_free_func((GDestroyNotify)fixture_frame_free);
+	for (f=0; ; f++) {
+		gchar *name = g_strdup_printf("%04u", f);
+		gchar *path = g_build_filename(argv[1], name, NULL);
+		gboolean exists = g_file_test(path, G_FILE_TEST_IS_DIR);
+
+		if (exists) {
+			FixtureFrame *frame = g_new0(FixtureFrame, 1);
+			frame->files = g_ptr_array_new_with_free_func((GDestroyNotify)fixture_file_free);
+			fixture_frame_load_dir(frame, path, "/");
+			g_ptr_array_add(frames, frame);
+		}
+
+		g_free(name);
+		g_free(path);
+		if (!exists)
+			break;
+	}
+	if (frames->len == 0) {
+		g_printerr ("No frames found in '%s'\n", argv[1]);
+		return 1;
+	}
+
+	workdir = g_dir_make_tmp("multiload-ng-replay-XXXXXX", &error);
+	if (workdir == NULL) {
+		g_printerr ("%s\n", error->message);
+		g_error_free (error);
+		return 1;
+	}
+
+	// collectors may look at files during init, so first frame goes in before
+	if (!fixture_frame_write(g_ptr_array_index(frames, 0), workdir)) {
+		remove_tree(workdir);
+		return 1;
+	}
+	info_file_set_sysroot(workdir);
+	multiload_config_init();
+
+	memset(stats, 0, sizeof(stats));
+	for (i=0; i<GRAPH_MAX; i++) {
+		collectors[i] = NULL;
+		if (!replay_graph_enabled(i))
+			continue;
+
+		collectors[i] = multiload_collector_new(i);
+		collectors[i]->interval = interval;
+		collectors[i]->width = opt_width;
+	}
+
+	for (r=0; r<(guint)MAX(opt_repeat, 1); r++) {
+		for (f=0; f<frames->len; f++) {
+			if (!fixture_frame_write(g_ptr_array_index(frames, f), workdir)) {
+				remove_tree(workdir);
+				return 1;
+			}
+
+			/* Frames are replayed faster than they were recorded, cached
+			 * /proc/stat would be reused across frames */
+			multiload_proc_stat_invalidate();
+
+			for (i=0; i<GRAPH_MAX; i++) {
+				if (collectors[i] == NULL)
+					continue;
+
+				// first sample takes the initial values, it is not measured
+				gboolean warmup = collectors[i]->first_update;
+
+				guint64 start = replay_now_ns();
+				multiload_collector_sample(collectors[i], values);
+				guint64 elapsed = replay_now_ns() - start;
+
+				if (warmup)
+					continue;
+				stats[i].samples++;
+				stats[i].total_ns += elapsed;
+				stats[i].max_ns = MAX(stats[i].max_ns, elapsed);
+			}
+		}
+	}
+
+	// one line per graph: name, samples, mean and max time (nanoseconds)
+	printf("# graph\tsamples\tmean_ns\tmax_ns\n");
+	for (i=0; i<GRAPH_MAX; i++) {
+		if (collectors[i] == NULL)
+			continue;
+
+		printf("%s\t%"G_GUINT64_FORMAT"\t%"G_GUINT64_FORMAT"\t%"G_GUINT64_FORMAT"\n",
+				graph_types[i].name, stats[i].samples,
+				stats[i].samples > 0 ? stats[i].total_ns / stats[i].samples : 0,
+				stats[i].max_ns);
+		multiload_collector_free(collectors[i]);
+	}
+
+	remove_tree(workdir);
+	g_free(workdir);
+	g_ptr_array_free(frames, TRUE);
+	return 0;
+}
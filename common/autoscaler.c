@@ -21,7 +21,8 @@
 
 
 #include <config.h>
-#include <time.h>
+#include <math.h>
+#include <string.h>
 #include <glib.h>
 
 #include "autoscaler.h"
@@ -29,10 +30,148 @@
 #include "multiload-config.h"
 
 
+// sketch buckets grow by 10%, so values are known within 10% of error
+#define AUTOSCALER_SKETCH_GAMMA 1.1
+
+// headroom above measured value
+#define AUTOSCALER_HEADROOM 1.2f
+
+// in percentile mode, max is lowered only when target goes below this fraction
+#define AUTOSCALER_HYSTERESIS 0.7f
+
+
+static guint
+autoscaler_sketch_bucket (int value)
+{
+	guint i;
+
+	if (value <= 0)
+		return 0;
+
+	i = 1 + (guint)(log(value) / log(AUTOSCALER_SKETCH_GAMMA));
+	return MIN(i, AUTOSCALER_SKETCH_BUCKETS-1);
+}
+
+/* Value at given percentile of the last n samples in ring buffer. Samples are
+ * copied on the stack and partially sorted (quickselect), no allocation. */
+static int
+autoscaler_ring_percentile (AutoScaler *s, guint n, guint percentile)
+{
+	int v[AUTOSCALER_RING_SIZE];
+	gint i, j, k, lo, hi;
+
+	n = MIN(n, s->ring_count);
+	if (n == 0)
+		return 0;
+
+	for (i = 0; i < (gint)n; i++)
+		v[i] = s->ring[(s->ring_pos + AUTOSCALER_RING_SIZE - 1 - i) % AUTOSCALER_RING_SIZE];
+
+	k = (n * percentile + 99) / 100;
+	k = CLAMP(k, 1, (gint)n) - 1;
+
+	lo = 0;
+	hi = n - 1;
+	while (lo < hi) {
+		int pivot = v[(lo + hi) / 2];
+		i = lo;
+		j = hi;
+		while (i <= j) {
+			while (v[i] < pivot)
+				i++;
+			while (v[j] > pivot)
+				j--;
+			if (i <= j) {
+				int tmp = v[i];
+				v[i++] = v[j];
+				v[j--] = tmp;
+			}
+		}
+		if (k <= j)
+			hi = j;
+		else if (k >= i)
+			lo = i;
+		else
+			break;
+	}
+
+	return v[k];
+}
+
+/* Value at given percentile from the sketch (both half windows), that is the
+ * upper bound of the bucket that contains it. */
+static int
+autoscaler_sketch_percentile (AutoScaler *s, guint percentile)
+{
+	guint i, total = 0, rank, seen = 0;
+
+	for (i = 0; i < AUTOSCALER_SKETCH_BUCKETS; i++)
+		total += s->sketch[0][i] + s->sketch[1][i];
+	if (total == 0)
+		return 0;
+
+	rank = MAX((total * percentile + 99) / 100, 1);
+	for (i = 0; i < AUTOSCALER_SKETCH_BUCKETS; i++) {
+		seen += s->sketch[0][i] + s->sketch[1][i];
+		if (seen >= rank)
+			break;
+	}
+
+	if (i == 0)
+		return 0;
+	return (int)MIN(ceil(pow(AUTOSCALER_SKETCH_GAMMA, i)), G_MAXINT);
+}
+
+static void
+autoscaler_update_percentile (AutoScaler *s, MultiloadCollector *c, int current, gint64 now, gint64 window, guint percentile)
+{
+	guint bucket;
+	int target;
+
+	s->ring[s->ring_pos] = current;
+	s->ring_pos = (s->ring_pos + 1) % AUTOSCALER_RING_SIZE;
+	if (s->ring_count < AUTOSCALER_RING_SIZE)
+		s->ring_count++;
+
+	// sketch covers between a half and a full window
+	if (now - s->sketch_start > window / 2) {
+		memcpy(s->sketch[1], s->sketch[0], sizeof(s->sketch[0]));
+		memset(s->sketch[0], 0, sizeof(s->sketch[0]));
+		s->sketch_start = now;
+	}
+	bucket = autoscaler_sketch_bucket(current);
+	if (s->sketch[0][bucket] < G_MAXUINT16)
+		s->sketch[0][bucket]++;
+
+	// there is one sample for each pixel column
+	if (c->width <= AUTOSCALER_RING_SIZE)
+		target = autoscaler_ring_percentile(s, c->width, percentile);
+	else
+		target = autoscaler_sketch_percentile(s, percentile);
+
+	target = MIN(target * AUTOSCALER_HEADROOM, G_MAXINT);
+
+	// grow right away, shrink only when target is well below current max
+	if (target > s->max || target < s->max * AUTOSCALER_HYSTERESIS) {
+		s->max = target;
+		g_debug("[autoscaler] Recalculated max for graph '%s': %d (p%u)", graph_types[c->id].name, s->max, percentile);
+	}
+}
+
+int
+autoscaler_get_max(AutoScaler *s, MultiloadCollector *c, int current)
+{
+	return autoscaler_get_max_at(s, c, current, g_get_monotonic_time());
+}
+
+/* Same as autoscaler_get_max, with given monotonic time (microseconds) as
+ * the time of current sample. Lets tests replay traces at any speed. */
 int
-autoscaler_get_max(AutoScaler *s, LoadGraph *g, int current)
+autoscaler_get_max_at(AutoScaler *s, MultiloadCollector *c, int current, gint64 now)
 {
-	time_t now;
+	gint64 window;
+	guint percentile;
+
 	if (current < 0)
 		current = 0;
 
@@ -40,10 +179,18 @@ autoscaler_get_max(AutoScaler *s, LoadGraph *g, int current)
 		s->min = AUTOSCALER_MIN_DEFAULT;
 
 	if (s->enable) {
+		window = (gint64)c->width * c->interval * 1000;
+		percentile = c->autoscaler_percentile;
+
+		if (percentile > 0) {
+			autoscaler_update_percentile(s, c, current, now, window, percentile);
+			s->max = MAX(s->max, s->min);
+			return s->max;
+		}
+
 		s->sum += current;
 		s->count++;
-		time(&now);
-		if ((gdouble)difftime(now, s->last_update) > (g->draw_width * g->config->interval / 1000)) {
+		if (now - s->last_update > window) {
 			gdouble new_average = s->sum / s->count;
 			gdouble average;
 
@@ -52,13 +199,13 @@ autoscaler_get_max(AutoScaler *s, LoadGraph *g, int current)
 			else
 				average = new_average;
 
-			s->max = average * 1.2f;
+			s->max = average * AUTOSCALER_HEADROOM;
 
 			s->sum = 0.0f;
 			s->count = 0;
 			s->last_update = now;
 			s->last_average = average;
-			g_debug("[autoscaler] Recalculated max for graph '%s': %d", graph_types[g->id].name, s->max);
+			g_debug("[autoscaler] Recalculated max for graph '%s': %d", graph_types[c->id].name, s->max);
 		}
 
 		s->max = MAX(s->max, current);
@@ -95,19 +242,20 @@ autoscaler_get_enabled(AutoScaler *s)
 
 
 AutoScaler*
-multiload_get_scaler (MultiloadPlugin *ma, guint graph_id)
+multiload_collector_get_scaler (MultiloadCollector *c)
 {
-	gpointer xd = ma->extra_data[graph_id];
+	gpointer xd = c->data;
 
-	switch(graph_id) {
+	switch(c->id) {
 		case GRAPH_CPULOAD:
 		case GRAPH_MEMLOAD:
-		case GRAPH_SWAPLOAD:
 		case GRAPH_BATTERY:
 			// no autoscaler
 			return NULL;
 		case GRAPH_NETLOAD:
 			return &((NetData*)xd)->scaler;
+		case GRAPH_SWAPLOAD:
+			return &((SwapData*)xd)->scaler;
 		case GRAPH_LOADAVG:
 			return &((LoadData*)xd)->scaler;
 		case GRAPH_DISKLOAD:
@@ -116,6 +264,10 @@ multiload_get_scaler (MultiloadPlugin *ma, guint graph_id)
 			return &((TemperatureData*)xd)->scaler;
 		case GRAPH_PARAMETRIC:
 			return &((ParametricData*)xd)->scaler;
+		case GRAPH_VMSTAT:
+			return &((VmData*)xd)->scaler;
+		case GRAPH_SCHED:
+			return &((SchedData*)xd)->scaler;
 		default:
 			g_assert_not_reached();
 	}
@@ -24,27 +24,39 @@
 #define __AUTOSCALER_H__
 
 #include <glib.h>
-#include <time.h>
 
-#include "multiload.h"
+#include "collector.h"
 
 G_BEGIN_DECLS
 
 #define AUTOSCALER_MIN_DEFAULT 20
 
+// percentile mode: exact on last samples, sketch for windows longer than that
+#define AUTOSCALER_RING_SIZE 128
+#define AUTOSCALER_SKETCH_BUCKETS 240
+
 typedef struct {
 	gboolean enable;
 	int max;
 	int min;
 	guint count;
-	time_t last_update;
+	gint64 last_update;		// monotonic time, microseconds
 	gdouble sum;
 	gdouble last_average;
+
+	// percentile mode
+	int ring[AUTOSCALER_RING_SIZE];
+	guint ring_pos;
+	guint ring_count;
+	guint16 sketch[2][AUTOSCALER_SKETCH_BUCKETS]; // current and previous half window
+	gint64 sketch_start;
 } AutoScaler;
 
 
 G_GNUC_INTERNAL int
-autoscaler_get_max(AutoScaler *s, LoadGraph *g, int current);
+autoscaler_get_max(AutoScaler *s, MultiloadCollector *c, int current);
+G_GNUC_INTERNAL int
+autoscaler_get_max_at(AutoScaler *s, MultiloadCollector *c, int current, gint64 now);
 G_GNUC_INTERNAL void
 autoscaler_set_max(AutoScaler *s, int max);
 
@@ -57,7 +69,7 @@ G_GNUC_INTERNAL gboolean
 autoscaler_get_enabled(AutoScaler *s);
 
 G_GNUC_INTERNAL AutoScaler*
-multiload_get_scaler (MultiloadPlugin *ma, guint graph_id);
+multiload_collector_get_scaler (MultiloadCollector *c);
 
 G_END_DECLS
 
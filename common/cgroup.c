@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cgroup.h"
+#include "info-file.h"
+
+
+// how deep to look for cgroups when building the list of available scopes
+#define CGROUP_MAX_DEPTH 4
+
+#define PATH_PRESSURE "/proc/pressure"
+
+
+static const gchar *cgroup_file_names[CGROUP_FILE_MAX] = {
+	"cpu.stat",
+	"cpu.max",
+	"memory.current",
+	"memory.max",
+	"memory.stat",
+	"io.stat",
+	"cpu.pressure",
+	"memory.pressure",
+	"io.pressure"
+};
+
+static const gchar *cgroup_resource_names[CGROUP_RESOURCE_MAX] = {
+	"cpu",
+	"memory",
+	"io"
+};
+
+typedef struct {
+	const gchar *key;
+	guint64 *address;
+} CgroupKeyEntry;
+
+
+gboolean
+multiload_cgroup_is_supported ()
+{
+	// cgroup v2 (unified hierarchy) is mounted on CGROUP_ROOT
+	return info_file_exists(CGROUP_ROOT "/cgroup.controllers");
+}
+
+MultiloadCgroup*
+multiload_cgroup_new (const gchar *scope)
+{
+	guint i;
+	MultiloadCgroup *cg = g_new0(MultiloadCgroup, 1);
+
+	while (*scope == '/')
+		scope++;
+
+	g_strlcpy(cg->scope, scope, sizeof(cg->scope));
+	g_snprintf(cg->path, sizeof(cg->path), "%s/%s", CGROUP_ROOT, cg->scope);
+
+	for (i=0; i<CGROUP_FILE_MAX; i++)
+		cg->fd[i] = -1;
+
+	cg->devnames = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+	g_debug("[cgroup] Monitoring scope set to '%s'", cg->path);
+	return cg;
+}
+
+void
+multiload_cgroup_free (MultiloadCgroup *cg)
+{
+	guint i;
+
+	if (cg == NULL)
+		return;
+
+	for (i=0; i<CGROUP_FILE_MAX; i++) {
+		if (cg->fd[i] >= 0)
+			close(cg->fd[i]);
+	}
+
+	g_hash_table_destroy(cg->devnames);
+	g_free(cg);
+}
+
+
+static gint
+multiload_cgroup_filter_compare (gconstpointer a, gconstpointer b)
+{
+	return strcmp(((MultiloadFilterElement*)a)->data, ((MultiloadFilterElement*)b)->data);
+}
+
+static void
+multiload_cgroup_scan (MultiloadFilter *filter, const gchar *relative, guint depth)
+{
+	const gchar *name;
+	gchar *path, *child, *child_path;
+	gchar buf[PATH_MAX];
+
+	path = g_build_filename(CGROUP_ROOT, relative, NULL);
+	GDir *dir = g_dir_open(info_file_path(path, buf), 0, NULL);
+	if (dir == NULL) {
+		g_free(path);
+		return;
+	}
+
+	while ((name = g_dir_read_name(dir)) != NULL) {
+		child_path = g_build_filename(path, name, NULL);
+
+		if (g_file_test(info_file_path(child_path, buf), G_FILE_TEST_IS_DIR)) {
+			if (relative[0] == '\0')
+				child = g_strdup(name);
+			else
+				child = g_build_filename(relative, name, NULL);
+
+			// filter elements have limited size, skip what does not fit
+			if (strlen(child) < sizeof(((MultiloadFilterElement*)NULL)->data)) {
+				multiload_filter_append(filter, child);
+
+				if (depth < CGROUP_MAX_DEPTH)
+					multiload_cgroup_scan(filter, child, depth+1);
+			}
+
+			g_free(child);
+		}
+
+		g_free(child_path);
+	}
+
+	g_dir_close(dir);
+	g_free(path);
+}
+
+MultiloadFilter*
+multiload_cgroup_get_filter (const gchar *scope)
+{
+	MultiloadFilter *filter = multiload_filter_new();
+
+	if (multiload_cgroup_is_supported()) {
+		multiload_cgroup_scan(filter, "", 1);
+		g_array_sort(filter->array, multiload_cgroup_filter_compare);
+	}
+
+	// marks current scope as selected (or absent, if the cgroup is gone)
+	if (scope != NULL && scope[0] != '\0')
+		multiload_filter_import_existing(filter, (gchar*)scope);
+
+	return filter;
+}
+
+
+/* Reads a whole cgroup file into buf. Descriptors are cached: cgroupfs
+ * regenerates file contents on every read at offset 0, so each sample
+ * costs just one pread() once the file is open. */
+static gssize
+multiload_cgroup_read_file (MultiloadCgroup *cg, MultiloadCgroupFile file, gchar *buf, gsize len)
+{
+	gchar path[PATH_MAX];
+	gssize n;
+
+	if (cg->fd[file] < 0) {
+		g_snprintf(path, sizeof(path), "%s/%s", cg->path, cgroup_file_names[file]);
+		cg->fd[file] = info_file_open(path, O_RDONLY | O_CLOEXEC);
+		if (cg->fd[file] < 0)
+			return -1;
+	}
+
+	n = pread(cg->fd[file], buf, len-1, 0);
+	if (n < 0) {
+		// cgroup has probably been removed: reopen on next call, it may come back
+		g_debug("[cgroup] Unable to read '%s/%s': %s", cg->path, cgroup_file_names[file], g_strerror(errno));
+		close(cg->fd[file]);
+		cg->fd[file] = -1;
+		return -1;
+	}
+
+	buf[n] = '\0';
+	return n;
+}
+
+/* Parses flat keyed files ("key value" lines), like cpu.stat and memory.stat */
+static guint
+multiload_cgroup_parse_keys (const gchar *buf, const CgroupKeyEntry *entries, guint count)
+{
+	const gchar *line, *sep;
+	size_t keylen;
+	guint i, found = 0;
+
+	for (line = buf; line != NULL && *line != '\0'; ) {
+		sep = strchr(line, ' ');
+		if (sep == NULL)
+			break;
+
+		keylen = sep - line;
+		for (i=0; i<count; i++) {
+			if (strncmp(line, entries[i].key, keylen) == 0 && entries[i].key[keylen] == '\0') {
+				*(entries[i].address) = g_ascii_strtoull(sep+1, NULL, 10);
+				found++;
+				break;
+			}
+		}
+
+		line = strchr(sep, '\n');
+		if (line != NULL)
+			line++;
+	}
+
+	return found;
+}
+
+static const gchar*
+multiload_cgroup_get_device_name (MultiloadCgroup *cg, const gchar *devnum)
+{
+	gchar path[PATH_MAX], buf[PATH_MAX];
+	gchar *target;
+
+	const gchar *name = g_hash_table_lookup(cg->devnames, devnum);
+	if (name != NULL)
+		return name;
+
+	// /sys/dev/block/MAJ:MIN is a symlink to the device directory, named after the device
+	g_snprintf(path, sizeof(path), "/sys/dev/block/%s", devnum);
+	target = g_file_read_link(info_file_path(path, buf), NULL);
+	if (target != NULL) {
+		name = g_path_get_basename(target);
+		g_free(target);
+	} else {
+		name = g_strdup(devnum);
+	}
+
+	g_hash_table_insert(cg->devnames, g_strdup(devnum), (gpointer)name);
+	return name;
+}
+
+/* io.stat only lists whole disks, so partitions selected in the disk filter
+ * select the disk they belong to. */
+static gboolean
+multiload_cgroup_filter_has_device (const gchar *filter, const gchar *device)
+{
+	const gchar *p, *end, *rest;
+	size_t len = strlen(device);
+
+	for (p = filter; *p != '\0'; p = end) {
+		end = strstr(p, MULTILOAD_FILTER_SEPARATOR);
+		if (end == NULL)
+			end = p + strlen(p);
+
+		if ((size_t)(end-p) >= len && strncmp(p, device, len) == 0) {
+			rest = p + len;
+			if (rest == end || g_ascii_isdigit(*rest) || (*rest == 'p' && g_ascii_isdigit(rest[1])))
+				return TRUE;
+		}
+
+		if (*end != '\0')
+			end += strlen(MULTILOAD_FILTER_SEPARATOR);
+	}
+
+	return FALSE;
+}
+
+
+gboolean
+multiload_cgroup_read_cpu (MultiloadCgroup *cg, MultiloadCgroupCpuStat *stat)
+{
+	gchar buf[512];
+	guint64 quota, period;
+
+	const CgroupKeyEntry table[] = {
+		{ "usage_usec",		&stat->usage_usec },
+		{ "user_usec",		&stat->user_usec },
+		{ "system_usec",	&stat->system_usec }
+	};
+
+	memset(stat, 0, sizeof(*stat));
+
+	if (multiload_cgroup_read_file(cg, CGROUP_FILE_CPU_STAT, buf, sizeof(buf)) < 0)
+		return FALSE;
+	if (multiload_cgroup_parse_keys(buf, table, G_N_ELEMENTS(table)) != G_N_ELEMENTS(table))
+		return FALSE;
+
+	// cpu.max is "$MAX $PERIOD", where $MAX can be "max" (no limit). Root cgroup does not have it.
+	if (multiload_cgroup_read_file(cg, CGROUP_FILE_CPU_MAX, buf, sizeof(buf)) > 0) {
+		if (sscanf(buf, "%"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT, &quota, &period) == 2 && period > 0)
+			stat->quota = (gdouble)quota / period;
+	}
+
+	return TRUE;
+}
+
+gboolean
+multiload_cgroup_read_memory (MultiloadCgroup *cg, MultiloadCgroupMemoryStat *stat)
+{
+	gchar buf[4096];
+
+	const CgroupKeyEntry table[] = {
+		{ "anon",				&stat->anon },
+		{ "file",				&stat->file },
+		{ "file_dirty",			&stat->file_dirty },
+		{ "file_writeback",		&stat->file_writeback },
+		{ "shmem",				&stat->shmem },
+		{ "slab_reclaimable",	&stat->slab_reclaimable }
+	};
+
+	memset(stat, 0, sizeof(*stat));
+
+	if (multiload_cgroup_read_file(cg, CGROUP_FILE_MEMORY_CURRENT, buf, sizeof(buf)) < 0)
+		return FALSE;
+	stat->current = g_ascii_strtoull(buf, NULL, 10);
+
+	// memory.max is "max" when there is no limit (parsed as 0). Root cgroup does not have it.
+	if (multiload_cgroup_read_file(cg, CGROUP_FILE_MEMORY_MAX, buf, sizeof(buf)) > 0)
+		stat->max = g_ascii_strtoull(buf, NULL, 10);
+
+	if (multiload_cgroup_read_file(cg, CGROUP_FILE_MEMORY_STAT, buf, sizeof(buf)) < 0)
+		return FALSE;
+	multiload_cgroup_parse_keys(buf, table, G_N_ELEMENTS(table));
+
+	return TRUE;
+}
+
+gboolean
+multiload_cgroup_read_io (MultiloadCgroup *cg, const gchar *filter, MultiloadCgroupIoStat *stat)
+{
+	gchar buf[4096];
+	gchar devnum[24];
+	gchar *line, *next, *pch;
+	const gchar *name;
+
+	memset(stat, 0, sizeof(*stat));
+
+	if (multiload_cgroup_read_file(cg, CGROUP_FILE_IO_STAT, buf, sizeof(buf)) < 0)
+		return FALSE;
+
+	// each line: "MAJ:MIN rbytes=... wbytes=... rios=... wios=... dbytes=... dios=..."
+	for (line = buf; line != NULL && *line != '\0'; line = next) {
+		next = strchr(line, '\n');
+		if (next != NULL)
+			*next++ = '\0';
+
+		pch = strchr(line, ' ');
+		if (pch == NULL || (size_t)(pch-line) >= sizeof(devnum))
+			continue;
+		g_strlcpy(devnum, line, pch-line+1);
+
+		name = multiload_cgroup_get_device_name(cg, devnum);
+		if (filter != NULL && !multiload_cgroup_filter_has_device(filter, name))
+			continue;
+
+		if ((pch = strstr(line, "rbytes=")) != NULL)
+			stat->rbytes += g_ascii_strtoull(pch+7, NULL, 10);
+		if ((pch = strstr(line, "wbytes=")) != NULL)
+			stat->wbytes += g_ascii_strtoull(pch+7, NULL, 10);
+
+		if (stat->devices[0] != '\0')
+			g_strlcat(stat->devices, ", ", sizeof(stat->devices));
+		g_strlcat(stat->devices, name, sizeof(stat->devices));
+	}
+
+	return TRUE;
+}
+
+gboolean
+multiload_cgroup_read_pressure (MultiloadCgroup *cg, MultiloadCgroupResource res, MultiloadPressure *pressure)
+{
+	gchar buf[256];
+	gchar path[PATH_MAX];
+	gchar *pch;
+
+	memset(pressure, 0, sizeof(*pressure));
+
+	if (cg != NULL) {
+		if (multiload_cgroup_read_file(cg, CGROUP_FILE_CPU_PRESSURE + res, buf, sizeof(buf)) < 0)
+			return FALSE;
+	} else {
+		// system wide pressure (requires CONFIG_PSI)
+		g_snprintf(path, sizeof(path), "%s/%s", PATH_PRESSURE, cgroup_resource_names[res]);
+		if (!info_file_read_string_s(path, buf, sizeof(buf), NULL))
+			return FALSE;
+	}
+
+	// "some avg10=0.00 avg60=0.00 avg300=0.00 total=0" (plus a "full" line)
+	if ((pch = strstr(buf, "some avg10=")) != NULL)
+		pressure->some_avg10 = g_ascii_strtod(pch+11, NULL);
+	if ((pch = strstr(buf, "full avg10=")) != NULL)
+		pressure->full_avg10 = g_ascii_strtod(pch+11, NULL);
+
+	pressure->valid = TRUE;
+	return TRUE;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __MULTILOAD_CGROUP_H__
+#define __MULTILOAD_CGROUP_H__
+
+#include <glib.h>
+#include <limits.h>
+
+#include "filter.h"
+
+
+G_BEGIN_DECLS
+
+#define CGROUP_ROOT "/sys/fs/cgroup"
+
+typedef enum {
+	CGROUP_FILE_CPU_STAT,
+	CGROUP_FILE_CPU_MAX,
+	CGROUP_FILE_MEMORY_CURRENT,
+	CGROUP_FILE_MEMORY_MAX,
+	CGROUP_FILE_MEMORY_STAT,
+	CGROUP_FILE_IO_STAT,
+	CGROUP_FILE_CPU_PRESSURE,
+	CGROUP_FILE_MEMORY_PRESSURE,
+	CGROUP_FILE_IO_PRESSURE,
+
+	CGROUP_FILE_MAX
+} MultiloadCgroupFile;
+
+typedef enum {
+	CGROUP_RESOURCE_CPU,
+	CGROUP_RESOURCE_MEMORY,
+	CGROUP_RESOURCE_IO,
+
+	CGROUP_RESOURCE_MAX
+} MultiloadCgroupResource;
+
+typedef struct _MultiloadCgroup {
+	gchar scope[512];		// relative to CGROUP_ROOT
+	gchar path[PATH_MAX];	// absolute
+	gint fd[CGROUP_FILE_MAX];
+
+	GHashTable *devnames;	// "major:minor" -> block device name
+} MultiloadCgroup;
+
+typedef struct {
+	guint64 usage_usec;
+	guint64 user_usec;
+	guint64 system_usec;
+	gdouble quota;			// CPUs allowed by cpu.max, 0 if unlimited
+} MultiloadCgroupCpuStat;
+
+typedef struct {
+	guint64 current;
+	guint64 max;			// 0 if unlimited
+	guint64 anon;
+	guint64 file;
+	guint64 file_dirty;
+	guint64 file_writeback;
+	guint64 shmem;
+	guint64 slab_reclaimable;
+} MultiloadCgroupMemoryStat;
+
+typedef struct {
+	guint64 rbytes;
+	guint64 wbytes;
+	gchar devices[128];
+} MultiloadCgroupIoStat;
+
+typedef struct {
+	gboolean valid;
+	gdouble some_avg10;
+	gdouble full_avg10;
+} MultiloadPressure;
+
+
+G_GNUC_INTERNAL gboolean
+multiload_cgroup_is_supported ();
+
+G_GNUC_INTERNAL MultiloadCgroup*
+multiload_cgroup_new (const gchar *scope);
+G_GNUC_INTERNAL void
+multiload_cgroup_free (MultiloadCgroup *cg);
+
+G_GNUC_INTERNAL MultiloadFilter*
+multiload_cgroup_get_filter (const gchar *scope);
+
+G_GNUC_INTERNAL gboolean
+multiload_cgroup_read_cpu (MultiloadCgroup *cg, MultiloadCgroupCpuStat *stat);
+G_GNUC_INTERNAL gboolean
+multiload_cgroup_read_memory (MultiloadCgroup *cg, MultiloadCgroupMemoryStat *stat);
+G_GNUC_INTERNAL gboolean
+multiload_cgroup_read_io (MultiloadCgroup *cg, const gchar *filter, MultiloadCgroupIoStat *stat);
+
+G_GNUC_INTERNAL gboolean
+multiload_cgroup_read_pressure (MultiloadCgroup *cg, MultiloadCgroupResource res, MultiloadPressure *pressure);
+
+G_END_DECLS
+
+#endif /* __MULTILOAD_CGROUP_H__ */
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+#include <config.h>
+
+#include <string.h>
+
+#include "autoscaler.h"
+#include "collector.h"
+#include "graph-data.h"
+#include "multiload-config.h"
+
+
+static gsize
+multiload_collector_get_data_size (guint id)
+{
+	switch(id) {
+		case GRAPH_CPULOAD:
+			return sizeof(CpuData);
+		case GRAPH_MEMLOAD:
+			return sizeof(MemoryData);
+		case GRAPH_NETLOAD:
+			return sizeof(NetData);
+		case GRAPH_SWAPLOAD:
+			return sizeof(SwapData);
+		case GRAPH_LOADAVG:
+			return sizeof(LoadData);
+		case GRAPH_DISKLOAD:
+			return sizeof(DiskData);
+		case GRAPH_TEMPERATURE:
+			return sizeof(TemperatureData);
+		case GRAPH_BATTERY:
+			return sizeof(BatteryData);
+		case GRAPH_PARAMETRIC:
+			return sizeof(ParametricData);
+		case GRAPH_VMSTAT:
+			return sizeof(VmData);
+		case GRAPH_SCHED:
+			return sizeof(SchedData);
+		default:
+			g_assert_not_reached();
+	}
+}
+
+/* multiload_config_init must have been called before. */
+MultiloadCollector*
+multiload_collector_new (guint id)
+{
+	MultiloadCollector *c;
+
+	g_assert_cmpuint(id, <, GRAPH_MAX);
+
+	c = g_new0(MultiloadCollector, 1);
+	c->id = id;
+	c->data = g_malloc0(multiload_collector_get_data_size(id));
+
+	// until the owner sets its own
+	c->interval = 1000;
+	c->filter = "";
+
+	c->first_update = TRUE;
+	c->strip_max = 1;
+	c->n_strips = 1;
+
+	if (graph_types[id].init != NULL)
+		graph_types[id].init(c, c->data);
+
+	return c;
+}
+
+/* Takes a new sample. Values holds num_data values for each of strip_max
+ * strips, as fractions of c->scale in MULTILOAD_COLLECTOR_DATA_ONE units. */
+void
+multiload_collector_sample (MultiloadCollector *c, gint *values)
+{
+	AutoScaler *scaler;
+
+	memset(c->scale, 0, sizeof(c->scale));
+	graph_types[c->id].get_data(MULTILOAD_COLLECTOR_DATA_ONE, values, c, c->data, c->first_update);
+
+	// graphs with an autoscaler do not need to set scale explicitly
+	if (c->scale[0] == 0) {
+		scaler = multiload_collector_get_scaler(c);
+		if (scaler != NULL)
+			c->scale[0] = scaler->max;
+	}
+
+	c->first_update = FALSE;
+}
+
+void
+multiload_collector_set_strips (MultiloadCollector *c, guint n)
+{
+	c->n_strips = CLAMP(n, 1, c->strip_max);
+}
+
+void
+multiload_collector_free (MultiloadCollector *c)
+{
+	if (c == NULL)
+		return;
+
+	if (graph_types[c->id].free != NULL)
+		graph_types[c->id].free(c, c->data);
+
+	g_free(c->data);
+	g_free(c);
+}
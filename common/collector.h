@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef __MULTILOAD_COLLECTOR_H__
+#define __MULTILOAD_COLLECTOR_H__
+
+#include <glib.h>
+
+#include "cgroup.h"
+
+
+G_BEGIN_DECLS
+
+#define MAX_STRIPS 8
+
+// fixed-point unit of collected values: a value of ONE fills the graph
+#define MULTILOAD_COLLECTOR_DATA_ONE (1 << 16)
+
+enum GraphType {
+	GRAPH_CPULOAD,
+	GRAPH_MEMLOAD,
+	GRAPH_NETLOAD,
+	GRAPH_SWAPLOAD,
+	GRAPH_LOADAVG,
+	GRAPH_DISKLOAD,
+	GRAPH_TEMPERATURE,
+	GRAPH_BATTERY,
+	GRAPH_PARAMETRIC,
+	GRAPH_VMSTAT,
+	GRAPH_SCHED,
+
+	GRAPH_MAX
+};
+
+enum MultiloadTooltipStyle {
+	MULTILOAD_TOOLTIP_STYLE_SIMPLE		= 0,
+	MULTILOAD_TOOLTIP_STYLE_DETAILED	= 1,
+
+	MULTILOAD_TOOLTIP_STYLE_N_VALUES	= 1
+};
+
+/* State of a data source, without any knowledge of widgets. Settings are
+ * copied here by the owner (a LoadGraph, or any program that links the
+ * collectors library) before taking a sample. */
+typedef struct _MultiloadCollector {
+	guint id;
+	gpointer data;			// depends on graph type (CpuData, MemoryData, ...)
+
+	// settings
+	gint interval;			// milliseconds between samples
+	guint width;			// samples shown at once, autoscaler window
+	const gchar *filter;
+	gboolean filter_enable;
+	gboolean size_format_iec;
+	gint autoscaler_percentile; // 0 for average mode
+	MultiloadCgroup *cgroup; // NULL when monitoring the whole system
+
+	gboolean first_update;
+	gboolean filter_changed;
+	gboolean tooltip_update; // collect details shown only in tooltip
+
+	// scale of current sample, set by graph functions (default from autoscaler)
+	gdouble scale[MAX_STRIPS];
+
+	// data can be split in strips, graphs that support them raise strip_max
+	guint strip_max;
+	guint n_strips;
+
+	char output_str[4][20];
+} MultiloadCollector;
+
+
+G_GNUC_INTERNAL MultiloadCollector*
+multiload_collector_new (guint id);
+G_GNUC_INTERNAL void
+multiload_collector_sample (MultiloadCollector *c, gint *values);
+G_GNUC_INTERNAL void
+multiload_collector_set_strips (MultiloadCollector *c, guint n);
+G_GNUC_INTERNAL void
+multiload_collector_free (MultiloadCollector *c);
+
+G_END_DECLS
+
+#endif /* __MULTILOAD_COLLECTOR_H__ */
@@ -50,7 +50,31 @@ typedef struct { // removed 'shared' from memory graph
 	GdkRGBA colors[8][7];
 } s_v5;
 
-typedef MultiloadColorScheme s_v6; //added battery, 2 colors
+typedef struct { // added battery, 2 colors
+	char name[24];
+	char **xpm_data;
+	GdkRGBA colors[9][7];
+} s_v6;
+
+typedef struct { // MAX_COLORS 7 -> 8, added dirty and huge pages to memory graph
+	char name[24];
+	char **xpm_data;
+	GdkRGBA colors[9][8];
+} s_v7;
+
+typedef struct { // added swap in/out to swap graph
+	char name[24];
+	char **xpm_data;
+	GdkRGBA colors[9][8];
+} s_v8;
+
+typedef struct { // added paging graph
+	char name[24];
+	char **xpm_data;
+	GdkRGBA colors[10][8];
+} s_v9;
+
+typedef MultiloadColorScheme s_v10; // added scheduler graph
 
 
 MultiloadColorSchemeStatus
@@ -64,6 +88,85 @@ multiload_color_scheme_parse (gpointer data, size_t length, guint32 version, Mul
 		memcpy(scheme, data, length);
 	}
 
+	else if (version == 9) {
+		if (length != sizeof(s_v9))
+			return MULTILOAD_COLOR_SCHEME_STATUS_WRONG_FORMAT;
+		/* CONVERT V9 TO V10
+		 * Changes: added Scheduler graph
+		 */
+		// new graph is at the end of the buffer, its colors are taken from default scheme
+		s_v10 *new = g_malloc0(sizeof(s_v10));
+		const GdkRGBA sched_default[5] = { HEX_TO_RGBA(43D1D1, FF), HEX_TO_RGBA(99DCDC, FF), HEX_TO_RGBA(008080, FF), HEX_TO_RGBA(132626, FF), HEX_TO_RGBA(000000, FF) };
+		memcpy(new, data, sizeof(s_v9));
+		memcpy(new->colors[10], sched_default, 5*sizeof(GdkRGBA));
+		MultiloadColorSchemeStatus ret = multiload_color_scheme_parse(new, sizeof(s_v10), version+1, scheme);
+		g_free(new);
+		return ret;
+	}
+	else if (version == 8) {
+		if (length != sizeof(s_v8))
+			return MULTILOAD_COLOR_SCHEME_STATUS_WRONG_FORMAT;
+		/* CONVERT V8 TO V9
+		 * Changes: added Paging graph
+		 */
+		// new graph is at the end of the buffer, its colors are taken from default scheme
+		s_v9 *new = g_malloc0(sizeof(s_v9));
+		const GdkRGBA vm_default[5] = { HEX_TO_RGBA(D143A2, FF), HEX_TO_RGBA(DC99C5, FF), HEX_TO_RGBA(800055, FF), HEX_TO_RGBA(261320, FF), HEX_TO_RGBA(000000, FF) };
+		memcpy(new, data, sizeof(s_v8));
+		memcpy(new->colors[9], vm_default, 5*sizeof(GdkRGBA));
+		MultiloadColorSchemeStatus ret = multiload_color_scheme_parse(new, sizeof(s_v9), version+1, scheme);
+		g_free(new);
+		return ret;
+	}
+	else if (version == 7) {
+		if (length != sizeof(s_v7))
+			return MULTILOAD_COLOR_SCHEME_STATUS_WRONG_FORMAT;
+		/* CONVERT V7 TO V8
+		 * Changes: added Swap in and Swap out colors to Swap graph
+		 */
+
+		s_v8 *new = g_malloc0(sizeof(s_v8));
+		memcpy(new, data, sizeof(s_v7));
+
+		// shift Swap graph border and background 2 positions right, new colors are taken from default scheme
+		GdkRGBA *swap_colors = new->colors[3];
+		const GdkRGBA swap_default[2] = { HEX_TO_RGBA(4349D1, FF), HEX_TO_RGBA(D143A7, FF) };
+		memmove(&swap_colors[3], &swap_colors[1], 3*sizeof(GdkRGBA));
+		memcpy(&swap_colors[1], swap_default, 2*sizeof(GdkRGBA));
+
+		MultiloadColorSchemeStatus ret = multiload_color_scheme_parse(new, sizeof(s_v8), version+1, scheme);
+		g_free(new);
+		return ret;
+	}
+
+	else if (version == 6) {
+		if (length != sizeof(s_v6))
+			return MULTILOAD_COLOR_SCHEME_STATUS_WRONG_FORMAT;
+		/* CONVERT V6 TO V7
+		 * Changes: every graph has room for 8 colors, Memory graph gained Dirty/Writeback and Huge pages
+		 */
+
+		s_v6 *old = (s_v6*)data;
+		s_v7 *new = g_malloc0(sizeof(s_v7));
+		guint i;
+
+		memcpy(new->name, old->name, 24);
+		new->xpm_data = old->xpm_data;
+		for (i=0; i<9; i++)
+			memcpy(new->colors[i], old->colors[i], 7*sizeof(GdkRGBA));
+
+		// shift Memory graph border and background 2 positions right, new colors are taken from default scheme
+		GdkRGBA *mem_colors = new->colors[1];
+		const GdkRGBA mem_default[2] = { HEX_TO_RGBA(D14387, FF), HEX_TO_RGBA(023B78, FF) };
+		memmove(&mem_colors[5], &mem_colors[3], 3*sizeof(GdkRGBA));
+		memcpy(&mem_colors[3], mem_default, 2*sizeof(GdkRGBA));
+
+		MultiloadColorSchemeStatus ret = multiload_color_scheme_parse(new, sizeof(s_v7), version+1, scheme);
+
+		g_free(new);
+		return ret;
+	}
+
 	else if (version == 5) {
 		if (length != sizeof(s_v5))
 			return MULTILOAD_COLOR_SCHEME_STATUS_WRONG_FORMAT;
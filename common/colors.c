@@ -312,6 +312,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(03964F, FF),		// User
 				HEX_TO_RGBA(43D18D, FF),		// Buffers
 				HEX_TO_RGBA(BFFFE0, FF),		// Cached
+				HEX_TO_RGBA(D14387, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(023B78, FF),		// Huge pages
 				HEX_TO_RGBA(008042, FF),		// Border
 				HEX_TO_RGBA(13261D, FF),		// Background (top)
 				HEX_TO_RGBA(000000, FF)			// Background (bottom)
@@ -324,6 +326,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(000000, FF)			// Background (bottom)
 			}, { // SWAP - hue: 278
 				HEX_TO_RGBA(9C43D1, FF),		// Used
+				HEX_TO_RGBA(4349D1, FF),		// Swap in
+				HEX_TO_RGBA(D143A7, FF),		// Swap out
 				HEX_TO_RGBA(510080, FF),		// Border
 				HEX_TO_RGBA(1F1326, FF),		// Background (top)
 				HEX_TO_RGBA(000000, FF)			// Background (bottom)
@@ -359,6 +363,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(808080, FF),		// Border
 				HEX_TO_RGBA(000000, FF),		// Background (top)
 				HEX_TO_RGBA(000000, FF)			// Background (bottom)
+			}, { // VM - hue: 320
+				HEX_TO_RGBA(D143A2, FF),		// Major faults
+				HEX_TO_RGBA(DC99C5, FF),		// Direct reclaim
+				HEX_TO_RGBA(800055, FF),		// Border
+				HEX_TO_RGBA(261320, FF),		// Background (top)
+				HEX_TO_RGBA(000000, FF)			// Background (bottom)
+			}, { // SCHED - hue: 180
+				HEX_TO_RGBA(43D1D1, FF),		// Context switches
+				HEX_TO_RGBA(99DCDC, FF),		// Interrupts
+				HEX_TO_RGBA(008080, FF),		// Border
+				HEX_TO_RGBA(132626, FF),		// Background (top)
+				HEX_TO_RGBA(000000, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -376,6 +392,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(3E6618, FF),		// User
 				HEX_TO_RGBA(73D216, FF),		// Buffers
 				HEX_TO_RGBA(ACFF5C, FF),		// Cached
+				HEX_TO_RGBA(7516D2, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(135233, FF),		// Huge pages
 				HEX_TO_RGBA(2E3436, FF),		// Border
 				HEX_TO_RGBA(888A85, FF),		// Background (top)
 				HEX_TO_RGBA(555753, FF)			// Background (bottom)
@@ -388,6 +406,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(555753, FF)			// Background (bottom)
 			}, { // SWAP - Tango Plum (dark)
 				HEX_TO_RGBA(5C3566, FF),		// Used
+				HEX_TO_RGBA(3B3566, FF),		// Swap in
+				HEX_TO_RGBA(66354F, FF),		// Swap out
 				HEX_TO_RGBA(2E3436, FF),		// Border
 				HEX_TO_RGBA(888A85, FF),		// Background (top)
 				HEX_TO_RGBA(555753, FF)			// Background (bottom)
@@ -423,6 +443,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(2E3436, FF),		// Border
 				HEX_TO_RGBA(888A85, FF),		// Background (top)
 				HEX_TO_RGBA(555753, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(A4006D, FF),		// Major faults
+				HEX_TO_RGBA(C7168C, FF),		// Direct reclaim
+				HEX_TO_RGBA(2E3436, FF),		// Border
+				HEX_TO_RGBA(888A85, FF),		// Background (top)
+				HEX_TO_RGBA(555753, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(00A4A4, FF),		// Context switches
+				HEX_TO_RGBA(16C7C7, FF),		// Interrupts
+				HEX_TO_RGBA(2E3436, FF),		// Border
+				HEX_TO_RGBA(888A85, FF),		// Background (top)
+				HEX_TO_RGBA(555753, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -440,6 +472,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(859900, FF),		// User
 				HEX_TO_RGBA(657B83, FF),		// Buffers
 				HEX_TO_RGBA(839496, FF),		// Cached
+				HEX_TO_RGBA(836D65, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(007A10, FF),		// Huge pages
 				HEX_TO_RGBA(586E75, FF),		// Border
 				HEX_TO_RGBA(073642, FF),		// Background (top)
 				HEX_TO_RGBA(002B36, FF)			// Background (bottom)
@@ -452,6 +486,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(002B36, FF)			// Background (bottom)
 			}, { // SWAP - Solarized Violet
 				HEX_TO_RGBA(6C71C4, FF),		// Used
+				HEX_TO_RGBA(6CACC4, FF),		// Swap in
+				HEX_TO_RGBA(A26CC4, FF),		// Swap out
 				HEX_TO_RGBA(586E75, FF),		// Border
 				HEX_TO_RGBA(073642, FF),		// Background (top)
 				HEX_TO_RGBA(002B36, FF)			// Background (bottom)
@@ -487,6 +523,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(586E75, FF),		// Border
 				HEX_TO_RGBA(073642, FF),		// Background (top)
 				HEX_TO_RGBA(002B36, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(DC2F9F, FF),		// Major faults
+				HEX_TO_RGBA(DF8AC1, FF),		// Direct reclaim
+				HEX_TO_RGBA(586E75, FF),		// Border
+				HEX_TO_RGBA(073642, FF),		// Background (top)
+				HEX_TO_RGBA(002B36, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(2FD9DC, FF),		// Context switches
+				HEX_TO_RGBA(8ADDDF, FF),		// Interrupts
+				HEX_TO_RGBA(586E75, FF),		// Border
+				HEX_TO_RGBA(073642, FF),		// Background (top)
+				HEX_TO_RGBA(002B36, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -504,6 +552,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(859900, FF),		// User
 				HEX_TO_RGBA(657B83, FF),		// Buffers
 				HEX_TO_RGBA(839496, FF),		// Cached
+				HEX_TO_RGBA(836D65, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(007A10, FF),		// Huge pages
 				HEX_TO_RGBA(586E75, FF),		// Border
 				HEX_TO_RGBA(FDF6E3, FF),		// Background (top)
 				HEX_TO_RGBA(EEE8D5, FF)			// Background (bottom)
@@ -516,6 +566,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(EEE8D5, FF)			// Background (bottom)
 			}, { // SWAP - Solarized Violet
 				HEX_TO_RGBA(6C71C4, FF),		// Used
+				HEX_TO_RGBA(6CACC4, FF),		// Swap in
+				HEX_TO_RGBA(A26CC4, FF),		// Swap out
 				HEX_TO_RGBA(586E75, FF),		// Border
 				HEX_TO_RGBA(FDF6E3, FF),		// Background (top)
 				HEX_TO_RGBA(EEE8D5, FF)			// Background (bottom)
@@ -551,6 +603,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(586E75, FF),		// Border
 				HEX_TO_RGBA(FDF6E3, FF),		// Background (top)
 				HEX_TO_RGBA(EEE8D5, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(DC2F9F, FF),		// Major faults
+				HEX_TO_RGBA(DF8AC1, FF),		// Direct reclaim
+				HEX_TO_RGBA(586E75, FF),		// Border
+				HEX_TO_RGBA(FDF6E3, FF),		// Background (top)
+				HEX_TO_RGBA(EEE8D5, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(2FD9DC, FF),		// Context switches
+				HEX_TO_RGBA(8ADDDF, FF),		// Interrupts
+				HEX_TO_RGBA(586E75, FF),		// Border
+				HEX_TO_RGBA(FDF6E3, FF),		// Background (top)
+				HEX_TO_RGBA(EEE8D5, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -570,6 +634,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(55641F, FF),		// User
 				HEX_TO_RGBA(789236, FF),		// Buffers
 				HEX_TO_RGBA(9AB452, FF),		// Cached
+				HEX_TO_RGBA(503692, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(195025, FF),		// Huge pages
 				HEX_TO_RGBA(404040, FF),		// Border
 				HEX_TO_RGBA(72511E, FF),		// Background (top)
 				HEX_TO_RGBA(809758, FF)			// Background (bottom)
@@ -582,6 +648,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(A79364, FF)			// Background (bottom)
 			}, { // SWAP - Grapes
 				HEX_TO_RGBA(821532, FF),		// Used
+				HEX_TO_RGBA(82157B, FF),		// Swap in
+				HEX_TO_RGBA(824115, FF),		// Swap out
 				HEX_TO_RGBA(404040, FF),		// Border
 				HEX_TO_RGBA(7A3C3F, FF),		// Background (top)
 				HEX_TO_RGBA(3B1719, FF)			// Background (bottom)
@@ -617,6 +685,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(404040, FF),		// Border
 				HEX_TO_RGBA(E2EBE3, FF),		// Background (top)
 				HEX_TO_RGBA(A0A7A1, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(8A0C61, FF),		// Major faults
+				HEX_TO_RGBA(A9217D, FF),		// Direct reclaim
+				HEX_TO_RGBA(404040, FF),		// Border
+				HEX_TO_RGBA(E0BEBC, FF),		// Background (top)
+				HEX_TO_RGBA(CE6370, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(0C8A89, FF),		// Context switches
+				HEX_TO_RGBA(21A9A8, FF),		// Interrupts
+				HEX_TO_RGBA(404040, FF),		// Border
+				HEX_TO_RGBA(E0BEBC, FF),		// Background (top)
+				HEX_TO_RGBA(CE6370, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -634,6 +714,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(FFFFFF, D8),		// User
 				HEX_TO_RGBA(FFFFFF, A5),		// Buffers
 				HEX_TO_RGBA(FFFFFF, 72),		// Cached
+				HEX_TO_RGBA(FFFFFF, A5),		// Dirty/Writeback
+				HEX_TO_RGBA(CCCCCC, D8),		// Huge pages
 				HEX_TO_RGBA(FFFFFF, FF),		// Border
 				HEX_TO_RGBA(BFFFE0, FF),		// Background (top)
 				HEX_TO_RGBA(43D18D, FF)			// Background (bottom)
@@ -646,6 +728,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(D7CD46, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(FFFFFF, D8),		// Used
+				HEX_TO_RGBA(FFFFFF, D8),		// Swap in
+				HEX_TO_RGBA(FFFFFF, D8),		// Swap out
 				HEX_TO_RGBA(FFFFFF, FF),		// Border
 				HEX_TO_RGBA(E6D6F0, FF),		// Background (top)
 				HEX_TO_RGBA(D0A1E1, FF)			// Background (bottom)
@@ -681,6 +765,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(FFFFFF, FF),		// Border
 				HEX_TO_RGBA(DDDDDD, FF),		// Background (top)
 				HEX_TO_RGBA(BBBBBB, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(FFFFFF, D8),		// Major faults
+				HEX_TO_RGBA(FFFFFF, D8),		// Direct reclaim
+				HEX_TO_RGBA(FFFFFF, FF),		// Border
+				HEX_TO_RGBA(EACECE, FF),		// Background (top)
+				HEX_TO_RGBA(DF8181, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(FFFFFF, D8),		// Context switches
+				HEX_TO_RGBA(FFFFFF, D8),		// Interrupts
+				HEX_TO_RGBA(FFFFFF, FF),		// Border
+				HEX_TO_RGBA(EACECE, FF),		// Background (top)
+				HEX_TO_RGBA(DF8181, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -700,6 +796,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(E96F20, FF),		// User
 				HEX_TO_RGBA(E96F20, FF),		// Buffers
 				HEX_TO_RGBA(E96F20, FF),		// Cached
+				HEX_TO_RGBA(209AE9, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(7DC113, FF),		// Huge pages
 				HEX_TO_RGBA(373737, FF),		// Border
 				HEX_TO_RGBA(300A24, FF),		// Background (top)
 				HEX_TO_RGBA(300A24, FF)			// Background (bottom)
@@ -712,6 +810,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(300A24, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(E96F20, FF),		// Used
+				HEX_TO_RGBA(E92057, FF),		// Swap in
+				HEX_TO_RGBA(DDE920, FF),		// Swap out
 				HEX_TO_RGBA(373737, FF),		// Border
 				HEX_TO_RGBA(300A24, FF),		// Background (top)
 				HEX_TO_RGBA(300A24, FF)			// Background (bottom)
@@ -747,6 +847,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(373737, FF),		// Border
 				HEX_TO_RGBA(300A24, FF),		// Background (top)
 				HEX_TO_RGBA(300A24, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(E92057, FF),		// Major faults
+				HEX_TO_RGBA(E5819C, FF),		// Direct reclaim
+				HEX_TO_RGBA(373737, FF),		// Border
+				HEX_TO_RGBA(300A24, FF),		// Background (top)
+				HEX_TO_RGBA(300A24, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(209AE9, FF),		// Context switches
+				HEX_TO_RGBA(81BEE5, FF),		// Interrupts
+				HEX_TO_RGBA(373737, FF),		// Border
+				HEX_TO_RGBA(300A24, FF),		// Background (top)
+				HEX_TO_RGBA(300A24, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -764,6 +876,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(E96F20, FF),		// User
 				HEX_TO_RGBA(E96F20, FF),		// Buffers
 				HEX_TO_RGBA(E96F20, FF),		// Cached
+				HEX_TO_RGBA(209AE9, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(7DC113, FF),		// Huge pages
 				HEX_TO_RGBA(D6D6D6, FF),		// Border
 				HEX_TO_RGBA(E8E8E8, FF),		// Background (top)
 				HEX_TO_RGBA(E8E8E8, FF)			// Background (bottom)
@@ -776,6 +890,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(E8E8E8, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(E96F20, FF),		// Used
+				HEX_TO_RGBA(E92057, FF),		// Swap in
+				HEX_TO_RGBA(DDE920, FF),		// Swap out
 				HEX_TO_RGBA(D6D6D6, FF),		// Border
 				HEX_TO_RGBA(E8E8E8, FF),		// Background (top)
 				HEX_TO_RGBA(E8E8E8, FF)			// Background (bottom)
@@ -811,6 +927,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(D6D6D6, FF),		// Border
 				HEX_TO_RGBA(E8E8E8, FF),		// Background (top)
 				HEX_TO_RGBA(E8E8E8, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(E92057, FF),		// Major faults
+				HEX_TO_RGBA(E5819C, FF),		// Direct reclaim
+				HEX_TO_RGBA(D6D6D6, FF),		// Border
+				HEX_TO_RGBA(E8E8E8, FF),		// Background (top)
+				HEX_TO_RGBA(E8E8E8, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(209AE9, FF),		// Context switches
+				HEX_TO_RGBA(81BEE5, FF),		// Interrupts
+				HEX_TO_RGBA(D6D6D6, FF),		// Border
+				HEX_TO_RGBA(E8E8E8, FF),		// Background (top)
+				HEX_TO_RGBA(E8E8E8, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -828,6 +956,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(97BF60, FF),		// User
 				HEX_TO_RGBA(97BF60, FF),		// Buffers
 				HEX_TO_RGBA(97BF60, FF),		// Cached
+				HEX_TO_RGBA(8860BF, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(42A46B, FF),		// Huge pages
 				HEX_TO_RGBA(3C3C3C, FF),		// Border
 				HEX_TO_RGBA(484848, FF),		// Background (top)
 				HEX_TO_RGBA(393939, FF)			// Background (bottom)
@@ -840,6 +970,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(393939, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(97BF60, FF),		// Used
+				HEX_TO_RGBA(BFA860, FF),		// Swap in
+				HEX_TO_RGBA(60BF68, FF),		// Swap out
 				HEX_TO_RGBA(3C3C3C, FF),		// Border
 				HEX_TO_RGBA(484848, FF),		// Background (top)
 				HEX_TO_RGBA(393939, FF)			// Background (bottom)
@@ -875,6 +1007,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(3C3C3C, FF),		// Border
 				HEX_TO_RGBA(484848, FF),		// Background (top)
 				HEX_TO_RGBA(393939, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(BFA860, FF),		// Major faults
+				HEX_TO_RGBA(D7CCAD, FF),		// Direct reclaim
+				HEX_TO_RGBA(3C3C3C, FF),		// Border
+				HEX_TO_RGBA(484848, FF),		// Background (top)
+				HEX_TO_RGBA(393939, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(8860BF, FF),		// Context switches
+				HEX_TO_RGBA(BEADD7, FF),		// Interrupts
+				HEX_TO_RGBA(3C3C3C, FF),		// Border
+				HEX_TO_RGBA(484848, FF),		// Background (top)
+				HEX_TO_RGBA(393939, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -892,6 +1036,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(199900, FF),		// User
 				HEX_TO_RGBA(2D652B, FF),		// Buffers
 				HEX_TO_RGBA(2D652B, FF),		// Cached
+				HEX_TO_RGBA(632B65, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(007A66, FF),		// Huge pages
 				HEX_TO_RGBA(004A00, FF),		// Border
 				HEX_TO_RGBA(003E00, FF),		// Background (top)
 				HEX_TO_RGBA(003E00, FF)			// Background (bottom)
@@ -904,6 +1050,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(C69408, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(AA40FF, FF),		// Used
+				HEX_TO_RGBA(4055FF, FF),		// Swap in
+				HEX_TO_RGBA(FF40D5, FF),		// Swap out
 				HEX_TO_RGBA(691BB8, FF),		// Border
 				HEX_TO_RGBA(57169A, FF),		// Background (top)
 				HEX_TO_RGBA(57169A, FF)			// Background (bottom)
@@ -939,6 +1087,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(606060, FF),		// Border
 				HEX_TO_RGBA(505050, FF),		// Background (top)
 				HEX_TO_RGBA(505050, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(FF1294, FF),		// Major faults
+				HEX_TO_RGBA(F180BE, FF),		// Direct reclaim
+				HEX_TO_RGBA(B81B1B, FF),		// Border
+				HEX_TO_RGBA(9E1716, FF),		// Background (top)
+				HEX_TO_RGBA(9E1716, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(12E3FF, FF),		// Context switches
+				HEX_TO_RGBA(80E3F1, FF),		// Interrupts
+				HEX_TO_RGBA(B81B1B, FF),		// Border
+				HEX_TO_RGBA(9E1716, FF),		// Background (top)
+				HEX_TO_RGBA(9E1716, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -958,6 +1118,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(5924E2, FF),		// User
 				HEX_TO_RGBA(5924E2, FF),		// Buffers
 				HEX_TO_RGBA(5924E2, FF),		// Cached
+				HEX_TO_RGBA(ADE224, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(B9198C, FF),		// Huge pages
 				HEX_TO_RGBA(1B1E24, FF),		// Border
 				HEX_TO_RGBA(383C4A, FF),		// Background (top)
 				HEX_TO_RGBA(383C4A, FF)			// Background (bottom)
@@ -970,6 +1132,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(383C4A, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(5924E2, FF),		// Used
+				HEX_TO_RGBA(246EE2, FF),		// Swap in
+				HEX_TO_RGBA(D824E2, FF),		// Swap out
 				HEX_TO_RGBA(1B1E24, FF),		// Border
 				HEX_TO_RGBA(383C4A, FF),		// Background (top)
 				HEX_TO_RGBA(383C4A, FF)			// Background (bottom)
@@ -1005,6 +1169,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(1B1E24, FF),		// Border
 				HEX_TO_RGBA(383C4A, FF),		// Background (top)
 				HEX_TO_RGBA(383C4A, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(246EE2, FF),		// Major faults
+				HEX_TO_RGBA(81A6E1, FF),		// Direct reclaim
+				HEX_TO_RGBA(1B1E24, FF),		// Border
+				HEX_TO_RGBA(383C4A, FF),		// Background (top)
+				HEX_TO_RGBA(383C4A, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(ADE224, FF),		// Context switches
+				HEX_TO_RGBA(C6E181, FF),		// Interrupts
+				HEX_TO_RGBA(1B1E24, FF),		// Border
+				HEX_TO_RGBA(383C4A, FF),		// Background (top)
+				HEX_TO_RGBA(383C4A, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1022,6 +1198,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(D64937, FF),		// User
 				HEX_TO_RGBA(D64937, FF),		// Buffers
 				HEX_TO_RGBA(D64937, FF),		// Cached
+				HEX_TO_RGBA(37C4D6, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(A3B325, FF),		// Huge pages
 				HEX_TO_RGBA(DEDEDE, FF),		// Border
 				HEX_TO_RGBA(333333, FF),		// Background (top)
 				HEX_TO_RGBA(333333, FF)			// Background (bottom)
@@ -1034,6 +1212,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(333333, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(D64937, FF),		// Used
+				HEX_TO_RGBA(D6378F, FF),		// Swap in
+				HEX_TO_RGBA(D6B337, FF),		// Swap out
 				HEX_TO_RGBA(DEDEDE, FF),		// Border
 				HEX_TO_RGBA(333333, FF),		// Background (top)
 				HEX_TO_RGBA(333333, FF)			// Background (bottom)
@@ -1069,6 +1249,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(DEDEDE, FF),		// Border
 				HEX_TO_RGBA(333333, FF),		// Background (top)
 				HEX_TO_RGBA(333333, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(D6378F, FF),		// Major faults
+				HEX_TO_RGBA(DC8FBA, FF),		// Direct reclaim
+				HEX_TO_RGBA(DEDEDE, FF),		// Border
+				HEX_TO_RGBA(333333, FF),		// Background (top)
+				HEX_TO_RGBA(333333, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(37C4D6, FF),		// Context switches
+				HEX_TO_RGBA(8FD4DC, FF),		// Interrupts
+				HEX_TO_RGBA(DEDEDE, FF),		// Border
+				HEX_TO_RGBA(333333, FF),		// Background (top)
+				HEX_TO_RGBA(333333, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1086,6 +1278,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(D64937, FF),		// User
 				HEX_TO_RGBA(D64937, FF),		// Buffers
 				HEX_TO_RGBA(D64937, FF),		// Cached
+				HEX_TO_RGBA(37C4D6, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(A3B325, FF),		// Huge pages
 				HEX_TO_RGBA(333333, FF),		// Border
 				HEX_TO_RGBA(DEDEDE, FF),		// Background (top)
 				HEX_TO_RGBA(DEDEDE, FF)			// Background (bottom)
@@ -1098,6 +1292,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(DEDEDE, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(D64937, FF),		// Used
+				HEX_TO_RGBA(D6378F, FF),		// Swap in
+				HEX_TO_RGBA(D6B337, FF),		// Swap out
 				HEX_TO_RGBA(333333, FF),		// Border
 				HEX_TO_RGBA(DEDEDE, FF),		// Background (top)
 				HEX_TO_RGBA(DEDEDE, FF)			// Background (bottom)
@@ -1133,6 +1329,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(333333, FF),		// Border
 				HEX_TO_RGBA(DEDEDE, FF),		// Background (top)
 				HEX_TO_RGBA(DEDEDE, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(D6378F, FF),		// Major faults
+				HEX_TO_RGBA(DC8FBA, FF),		// Direct reclaim
+				HEX_TO_RGBA(333333, FF),		// Border
+				HEX_TO_RGBA(DEDEDE, FF),		// Background (top)
+				HEX_TO_RGBA(DEDEDE, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(37C4D6, FF),		// Context switches
+				HEX_TO_RGBA(8FD4DC, FF),		// Interrupts
+				HEX_TO_RGBA(333333, FF),		// Border
+				HEX_TO_RGBA(DEDEDE, FF),		// Background (top)
+				HEX_TO_RGBA(DEDEDE, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1152,6 +1360,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(DA0000, FF),		// User
 				HEX_TO_RGBA(716800, FF),		// Buffers
 				HEX_TO_RGBA(FAB100, FF),		// Cached
+				HEX_TO_RGBA(000971, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(AEAE00, FF),		// Huge pages
 				HEX_TO_RGBA(030000, FF),		// Border
 				HEX_TO_RGBA(6385FB, FF),		// Background (top)
 				HEX_TO_RGBA(6385FB, FF)			// Background (bottom)
@@ -1164,6 +1374,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(6385FB, FF)			// Background (bottom)
 			}, { // SWAP - Coin
 				HEX_TO_RGBA(FAB930, FF),		// Used
+				HEX_TO_RGBA(FA3230, FF),		// Swap in
+				HEX_TO_RGBA(B4FA30, FF),		// Swap out
 				HEX_TO_RGBA(030000, FF),		// Border
 				HEX_TO_RGBA(6385FB, FF),		// Background (top)
 				HEX_TO_RGBA(6385FB, FF)			// Background (bottom)
@@ -1199,6 +1411,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(030000, FF),		// Border
 				HEX_TO_RGBA(6385FB, FF),		// Background (top)
 				HEX_TO_RGBA(6385FB, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(B9B9B9, FF),		// Major faults
+				HEX_TO_RGBA(FAFAFA, FF),		// Direct reclaim
+				HEX_TO_RGBA(030000, FF),		// Border
+				HEX_TO_RGBA(6385FB, FF),		// Background (top)
+				HEX_TO_RGBA(6385FB, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(B9B9B9, FF),		// Context switches
+				HEX_TO_RGBA(FAFAFA, FF),		// Interrupts
+				HEX_TO_RGBA(030000, FF),		// Border
+				HEX_TO_RGBA(6385FB, FF),		// Background (top)
+				HEX_TO_RGBA(6385FB, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1216,6 +1440,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(333098, FF),		// User
 				HEX_TO_RGBA(FDC9AB, FF),		// Buffers
 				HEX_TO_RGBA(11141B, FF),		// Cached
+				HEX_TO_RGBA(ABDFFD, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(7A2677, FF),		// Huge pages
 				HEX_TO_RGBA(11141B, FF),		// Border
 				HEX_TO_RGBA(FD5700, FF),		// Background (top)
 				HEX_TO_RGBA(FD5700, FF)			// Background (bottom)
@@ -1228,6 +1454,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(323399, FF)			// Background (bottom)
 			}, { // SWAP - Boo
 				HEX_TO_RGBA(FD9899, FF),		// Used
+				HEX_TO_RGBA(FD98DC, FF),		// Swap in
+				HEX_TO_RGBA(FDDA98, FF),		// Swap out
 				HEX_TO_RGBA(11141B, FF),		// Border
 				HEX_TO_RGBA(D9D9D9, FF),		// Background (top)
 				HEX_TO_RGBA(D9D9D9, FF)			// Background (bottom)
@@ -1263,6 +1491,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(11141B, FF),		// Border
 				HEX_TO_RGBA(337F37, FF),		// Background (top)
 				HEX_TO_RGBA(337F37, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(0005FF, FF),		// Major faults
+				HEX_TO_RGBA(6A6CEE, FF),		// Direct reclaim
+				HEX_TO_RGBA(11141B, FF),		// Border
+				HEX_TO_RGBA(D9D9D9, FF),		// Background (top)
+				HEX_TO_RGBA(D9D9D9, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(5AFF00, FF),		// Context switches
+				HEX_TO_RGBA(99EE6A, FF),		// Interrupts
+				HEX_TO_RGBA(11141B, FF),		// Border
+				HEX_TO_RGBA(D9D9D9, FF),		// Background (top)
+				HEX_TO_RGBA(D9D9D9, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1280,6 +1520,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(0F9BE0, FF),		// User
 				HEX_TO_RGBA(F15B30, FF),		// Buffers
 				HEX_TO_RGBA(FED420, FF),		// Cached
+				HEX_TO_RGBA(30C6F1, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(430CB3, FF),		// Huge pages
 				HEX_TO_RGBA(84C55F, FF),		// Border
 				HEX_TO_RGBA(84C55F, FF),		// Background (top)
 				HEX_TO_RGBA(84C55F, FF)			// Background (bottom)
@@ -1292,6 +1534,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(F15B30, FF)			// Background (bottom)
 			}, { // SWAP - Little Santa's Helper
 				HEX_TO_RGBA(FFFFFF, FF),		// Used
+				HEX_TO_RGBA(FFFFFF, FF),		// Swap in
+				HEX_TO_RGBA(FFFFFF, FF),		// Swap out
 				HEX_TO_RGBA(000000, FF),		// Border
 				HEX_TO_RGBA(C37C14, FF),		// Background (top)
 				HEX_TO_RGBA(C37C14, FF)			// Background (bottom)
@@ -1327,6 +1571,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(98887B, FF),		// Border
 				HEX_TO_RGBA(98887B, FF),		// Background (top)
 				HEX_TO_RGBA(98887B, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(E388FF, FF),		// Major faults
+				HEX_TO_RGBA(FFFFFF, FF),		// Direct reclaim
+				HEX_TO_RGBA(2099AA, FF),		// Border
+				HEX_TO_RGBA(475556, FF),		// Background (top)
+				HEX_TO_RGBA(475556, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(88FFBB, FF),		// Context switches
+				HEX_TO_RGBA(FFFFFF, FF),		// Interrupts
+				HEX_TO_RGBA(2099AA, FF),		// Border
+				HEX_TO_RGBA(475556, FF),		// Background (top)
+				HEX_TO_RGBA(475556, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1346,6 +1602,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(777777, FF),		// User
 				HEX_TO_RGBA(777777, FF),		// Buffers
 				HEX_TO_RGBA(777777, FF),		// Cached
+				HEX_TO_RGBA(777777, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(5F5F5F, FF),		// Huge pages
 				HEX_TO_RGBA(142339, FF),		// Border
 				HEX_TO_RGBA(CBCBCB, FF),		// Background (top)
 				HEX_TO_RGBA(B5B5B5, FF)			// Background (bottom)
@@ -1358,6 +1616,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(B5B5B5, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(909090, FF),		// Used
+				HEX_TO_RGBA(909090, FF),		// Swap in
+				HEX_TO_RGBA(909090, FF),		// Swap out
 				HEX_TO_RGBA(142329, FF),		// Border
 				HEX_TO_RGBA(CBCBCB, FF),		// Background (top)
 				HEX_TO_RGBA(B5B5B5, FF)			// Background (bottom)
@@ -1393,6 +1653,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(142339, FF),		// Border
 				HEX_TO_RGBA(CBCBCB, FF),		// Background (top)
 				HEX_TO_RGBA(B5B5B5, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(2D2D2D, FF),		// Major faults
+				HEX_TO_RGBA(3D3D3D, FF),		// Direct reclaim
+				HEX_TO_RGBA(142339, FF),		// Border
+				HEX_TO_RGBA(CBCBCB, FF),		// Background (top)
+				HEX_TO_RGBA(B5B5B5, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(2D2D2D, FF),		// Context switches
+				HEX_TO_RGBA(3D3D3D, FF),		// Interrupts
+				HEX_TO_RGBA(142339, FF),		// Border
+				HEX_TO_RGBA(CBCBCB, FF),		// Background (top)
+				HEX_TO_RGBA(B5B5B5, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1410,6 +1682,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(E7D520, FF),		// User
 				HEX_TO_RGBA(E7D520, FF),		// Buffers
 				HEX_TO_RGBA(E7D520, FF),		// Cached
+				HEX_TO_RGBA(2032E7, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(24BE14, FF),		// Huge pages
 				HEX_TO_RGBA(E39E1C, FF),		// Border
 				HEX_TO_RGBA(C18F17, FF),		// Background (top)
 				HEX_TO_RGBA(A57C1B, FF)			// Background (bottom)
@@ -1422,6 +1696,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(A57C1B, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(F4C44F, FF),		// Used
+				HEX_TO_RGBA(F4564F, FF),		// Swap in
+				HEX_TO_RGBA(B6F44F, FF),		// Swap out
 				HEX_TO_RGBA(E39E1C, FF),		// Border
 				HEX_TO_RGBA(C18F17, FF),		// Background (top)
 				HEX_TO_RGBA(A57C1B, FF)			// Background (bottom)
@@ -1457,6 +1733,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(E39E1C, FF),		// Border
 				HEX_TO_RGBA(C18F17, FF),		// Background (top)
 				HEX_TO_RGBA(A57C1B, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(F57A82, FF),		// Major faults
+				HEX_TO_RGBA(FDF3F3, FF),		// Direct reclaim
+				HEX_TO_RGBA(E39E1C, FF),		// Border
+				HEX_TO_RGBA(C18F17, FF),		// Background (top)
+				HEX_TO_RGBA(A57C1B, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(7AABF5, FF),		// Context switches
+				HEX_TO_RGBA(F3F7FD, FF),		// Interrupts
+				HEX_TO_RGBA(E39E1C, FF),		// Border
+				HEX_TO_RGBA(C18F17, FF),		// Background (top)
+				HEX_TO_RGBA(A57C1B, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1474,6 +1762,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(73591C, FF),		// User
 				HEX_TO_RGBA(B6974F, FF),		// Buffers
 				HEX_TO_RGBA(E1C584, FF),		// Cached
+				HEX_TO_RGBA(4F6EB6, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(2B5C16, FF),		// Huge pages
 				HEX_TO_RGBA(24313A, FF),		// Border
 				HEX_TO_RGBA(79BDD8, FF),		// Background (top)
 				HEX_TO_RGBA(006287, FF)			// Background (bottom)
@@ -1486,6 +1776,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(006287, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(B6DEED, FF),		// Used
+				HEX_TO_RGBA(B6EDD7, FF),		// Swap in
+				HEX_TO_RGBA(B6B9ED, FF),		// Swap out
 				HEX_TO_RGBA(24313A, FF),		// Border
 				HEX_TO_RGBA(79BDD8, FF),		// Background (top)
 				HEX_TO_RGBA(006287, FF)			// Background (bottom)
@@ -1521,6 +1813,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(24313A, FF),		// Border
 				HEX_TO_RGBA(79BDD8, FF),		// Background (top)
 				HEX_TO_RGBA(006287, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(EF8671, FF),		// Major faults
+				HEX_TO_RGBA(F9E6E2, FF),		// Direct reclaim
+				HEX_TO_RGBA(24313A, FF),		// Border
+				HEX_TO_RGBA(79BDD8, FF),		// Background (top)
+				HEX_TO_RGBA(006287, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(7186EF, FF),		// Context switches
+				HEX_TO_RGBA(E2E6F9, FF),		// Interrupts
+				HEX_TO_RGBA(24313A, FF),		// Border
+				HEX_TO_RGBA(79BDD8, FF),		// Background (top)
+				HEX_TO_RGBA(006287, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1538,6 +1842,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(D66456, FF),		// User
 				HEX_TO_RGBA(D66456, FF),		// Buffers
 				HEX_TO_RGBA(D66456, FF),		// Cached
+				HEX_TO_RGBA(56C8D6, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(B1C12F, FF),		// Huge pages
 				HEX_TO_RGBA(733E34, FF),		// Border
 				HEX_TO_RGBA(A27643, FF),		// Background (top)
 				HEX_TO_RGBA(45413F, FF)			// Background (bottom)
@@ -1550,6 +1856,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(45413F, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(F41D03, FF),		// Used
+				HEX_TO_RGBA(F4038A, FF),		// Swap in
+				HEX_TO_RGBA(F4BE03, FF),		// Swap out
 				HEX_TO_RGBA(733E34, FF),		// Border
 				HEX_TO_RGBA(A27643, FF),		// Background (top)
 				HEX_TO_RGBA(45413F, FF)			// Background (bottom)
@@ -1585,6 +1893,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(733E34, FF),		// Border
 				HEX_TO_RGBA(A27643, FF),		// Background (top)
 				HEX_TO_RGBA(45413F, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(C00469, FF),		// Major faults
+				HEX_TO_RGBA(E2268C, FF),		// Direct reclaim
+				HEX_TO_RGBA(733E34, FF),		// Border
+				HEX_TO_RGBA(A27643, FF),		// Background (top)
+				HEX_TO_RGBA(45413F, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(04A8C0, FF),		// Context switches
+				HEX_TO_RGBA(26CAE2, FF),		// Interrupts
+				HEX_TO_RGBA(733E34, FF),		// Border
+				HEX_TO_RGBA(A27643, FF),		// Background (top)
+				HEX_TO_RGBA(45413F, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1602,6 +1922,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(1A8A14, FF),		// User
 				HEX_TO_RGBA(1A8A14, FF),		// Buffers
 				HEX_TO_RGBA(1A8A14, FF),		// Cached
+				HEX_TO_RGBA(84148A, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(106E6A, FF),		// Huge pages
 				HEX_TO_RGBA(3B763B, FF),		// Border
 				HEX_TO_RGBA(C5C0AA, FF),		// Background (top)
 				HEX_TO_RGBA(063D06, FF)			// Background (bottom)
@@ -1614,6 +1936,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(063D06, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(7AFB49, FF),		// Used
+				HEX_TO_RGBA(F1FB49, FF),		// Swap in
+				HEX_TO_RGBA(49FB8F, FF),		// Swap out
 				HEX_TO_RGBA(3B763B, FF),		// Border
 				HEX_TO_RGBA(C5C0AA, FF),		// Background (top)
 				HEX_TO_RGBA(063D06, FF)			// Background (bottom)
@@ -1649,6 +1973,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(3B763B, FF),		// Border
 				HEX_TO_RGBA(C5C0AA, FF),		// Background (top)
 				HEX_TO_RGBA(063D06, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(8AFD02, FF),		// Major faults
+				HEX_TO_RGBA(B2ED6B, FF),		// Direct reclaim
+				HEX_TO_RGBA(3B763B, FF),		// Border
+				HEX_TO_RGBA(C5C0AA, FF),		// Background (top)
+				HEX_TO_RGBA(063D06, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(FD02DE, FF),		// Context switches
+				HEX_TO_RGBA(ED6BDD, FF),		// Interrupts
+				HEX_TO_RGBA(3B763B, FF),		// Border
+				HEX_TO_RGBA(C5C0AA, FF),		// Background (top)
+				HEX_TO_RGBA(063D06, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1666,6 +2002,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(30ABC0, FF),		// User
 				HEX_TO_RGBA(30ABC0, FF),		// Buffers
 				HEX_TO_RGBA(30ABC0, FF),		// Cached
+				HEX_TO_RGBA(C04530, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(37269A, FF),		// Huge pages
 				HEX_TO_RGBA(101010, FF),		// Border
 				HEX_TO_RGBA(228499, FF),		// Background (top)
 				HEX_TO_RGBA(03444A, FF)			// Background (bottom)
@@ -1678,6 +2016,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(03444A, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(BCDBE3, FF),		// Used
+				HEX_TO_RGBA(BCE3D1, FF),		// Swap in
+				HEX_TO_RGBA(BCC1E3, FF),		// Swap out
 				HEX_TO_RGBA(101010, FF),		// Border
 				HEX_TO_RGBA(228499, FF),		// Background (top)
 				HEX_TO_RGBA(03444A, FF)			// Background (bottom)
@@ -1713,6 +2053,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(101010, FF),		// Border
 				HEX_TO_RGBA(228499, FF),		// Background (top)
 				HEX_TO_RGBA(03444A, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(72E099, FF),		// Major faults
+				HEX_TO_RGBA(D6F2E0, FF),		// Direct reclaim
+				HEX_TO_RGBA(101010, FF),		// Border
+				HEX_TO_RGBA(228499, FF),		// Background (top)
+				HEX_TO_RGBA(03444A, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(E07472, FF),		// Context switches
+				HEX_TO_RGBA(F2D7D6, FF),		// Interrupts
+				HEX_TO_RGBA(101010, FF),		// Border
+				HEX_TO_RGBA(228499, FF),		// Background (top)
+				HEX_TO_RGBA(03444A, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -1730,6 +2082,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(5A7BE4, FF),		// User
 				HEX_TO_RGBA(5A7BE4, FF),		// Buffers
 				HEX_TO_RGBA(5A7BE4, FF),		// Cached
+				HEX_TO_RGBA(E4C35A, FF),		// Dirty/Writeback
+				HEX_TO_RGBA(AF24DB, FF),		// Huge pages
 				HEX_TO_RGBA(142339, FF),		// Border
 				HEX_TO_RGBA(6459CA, FF),		// Background (top)
 				HEX_TO_RGBA(3D2B67, FF)			// Background (bottom)
@@ -1742,6 +2096,8 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(3D2B67, FF)			// Background (bottom)
 			}, { // SWAP
 				HEX_TO_RGBA(8397D6, FF),		// Used
+				HEX_TO_RGBA(83CED6, FF),		// Swap in
+				HEX_TO_RGBA(A683D6, FF),		// Swap out
 				HEX_TO_RGBA(142339, FF),		// Border
 				HEX_TO_RGBA(6459CA, FF),		// Background (top)
 				HEX_TO_RGBA(3D2B67, FF)			// Background (bottom)
@@ -1777,6 +2133,18 @@ const MultiloadColorScheme multiload_builtin_color_schemes[] = {
 				HEX_TO_RGBA(142339, FF),		// Border
 				HEX_TO_RGBA(6459CA, FF),		// Background (top)
 				HEX_TO_RGBA(3D2B67, FF)			// Background (bottom)
+			}, { // VM
+				HEX_TO_RGBA(B0D9CD, FF),		// Major faults
+				HEX_TO_RGBA(FFFFFF, FF),		// Direct reclaim
+				HEX_TO_RGBA(142339, FF),		// Border
+				HEX_TO_RGBA(6459CA, FF),		// Background (top)
+				HEX_TO_RGBA(3D2B67, FF)			// Background (bottom)
+			}, { // SCHED
+				HEX_TO_RGBA(D9BFB0, FF),		// Context switches
+				HEX_TO_RGBA(FFFFFF, FF),		// Interrupts
+				HEX_TO_RGBA(142339, FF),		// Border
+				HEX_TO_RGBA(6459CA, FF),		// Background (top)
+				HEX_TO_RGBA(3D2B67, FF)			// Background (bottom)
 			}
 		}
 	},
@@ -37,7 +37,7 @@ G_BEGIN_DECLS
 #define HEX_TO_RGBA_SPLIT(r, g, b, a) {(gdouble)(0x##r)/255.0, (gdouble)(0x##g)/255.0, (gdouble)(0x##b)/255.0, (gdouble)(0x##a)/255.0}
 
 // Format version. Increment this every time color scheme format changes.
-#define MULTILOAD_COLOR_SCHEME_VERSION 6
+#define MULTILOAD_COLOR_SCHEME_VERSION 10
 
 // Header of the color scheme file. This must never change.
 #define MULTILOAD_COLOR_SCHEME_HEADER_SIZE 12
@@ -62,14 +62,6 @@ typedef enum {
 
 extern const MultiloadColorScheme multiload_builtin_color_schemes[];
 
-typedef enum {
-	EXTRA_COLOR_BORDER = 0,
-	EXTRA_COLOR_BACKGROUND_TOP,
-	EXTRA_COLOR_BACKGROUND_BOTTOM,
-
-	EXTRA_COLORS
-} MultiloadExtraColor;
-
 G_GNUC_INTERNAL guint
 multiload_colors_get_extra_index(guint i, MultiloadExtraColor col);
 
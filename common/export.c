@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+
+#include "export.h"
+
+// instances running at the same time (one slot each)
+#define EXPORT_MAX_SLOTS 16
+
+
+/* Slots are locked while in use, so files left by a crashed instance are
+ * taken over instead of piling up. */
+static gint
+multiload_export_open_slot (const gchar *dir, gchar **filename)
+{
+	guint i;
+	gint fd;
+
+	for (i = 0; i < EXPORT_MAX_SLOTS; i++) {
+		*filename = g_strdup_printf("%s/export-%u", dir, i);
+		fd = open(*filename, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+		if (fd >= 0) {
+			if (flock(fd, LOCK_EX | LOCK_NB) == 0)
+				return fd;
+			close(fd);
+		}
+		g_free(*filename);
+	}
+
+	*filename = NULL;
+	return -1;
+}
+
+MultiloadExport*
+multiload_export_new ()
+{
+	MultiloadExport *ex;
+	MultiloadExportHeader hdr;
+	gpointer block;
+	gchar *dir, *filename;
+	gsize size = sizeof(MultiloadExportHeader) + MULTILOAD_EXPORT_RECORDS * sizeof(MultiloadExportRecord);
+	gint fd;
+
+	dir = g_build_filename(g_get_user_runtime_dir(), "multiload-ng", NULL);
+	if (g_mkdir_with_parents(dir, 0700) != 0) {
+		g_warning("[export] Unable to create directory '%s'", dir);
+		g_free(dir);
+		return NULL;
+	}
+
+	fd = multiload_export_open_slot(dir, &filename);
+	g_free(dir);
+	if (fd < 0) {
+		g_warning("[export] No free export slot");
+		return NULL;
+	}
+
+	// readers may have the old file mapped: start over from an empty file
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = MULTILOAD_EXPORT_MAGIC;
+	hdr.version = MULTILOAD_EXPORT_VERSION;
+	hdr.record_size = sizeof(MultiloadExportRecord);
+	hdr.n_records = MULTILOAD_EXPORT_RECORDS;
+
+	if (ftruncate(fd, 0) != 0 || ftruncate(fd, size) != 0 || pwrite(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr)) {
+		g_warning("[export] Unable to write '%s': %s", filename, g_strerror(errno));
+		goto fail;
+	}
+
+	block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (block == MAP_FAILED) {
+		g_warning("[export] Unable to map '%s': %s", filename, g_strerror(errno));
+		goto fail;
+	}
+
+	ex = g_new0(MultiloadExport, 1);
+	ex->header = block;
+	ex->records = (MultiloadExportRecord*)((guchar*)block + sizeof(MultiloadExportHeader));
+	ex->filename = filename;
+	ex->fd = fd;
+
+	g_debug("[export] Exporting samples to '%s'", filename);
+	return ex;
+
+fail:
+	unlink(filename);
+	close(fd);
+	g_free(filename);
+	return NULL;
+}
+
+void
+multiload_export_free (MultiloadExport *ex)
+{
+	if (ex == NULL)
+		return;
+
+	munmap(ex->header, sizeof(MultiloadExportHeader) + MULTILOAD_EXPORT_RECORDS * sizeof(MultiloadExportRecord));
+	unlink(ex->filename);
+	close(ex->fd);
+	g_free(ex->filename);
+	g_free(ex);
+}
+
+/* Only stores into shared memory: no system calls, and nothing to do for
+ * readers. Values that do not fit in a record are dropped. */
+void
+multiload_export_write (MultiloadExport *ex, guint graph_id, gint64 time, const gint32 *values, guint n_values, const gfloat *scales, guint n_scales)
+{
+	guint64 count = ex->header->write_count;
+	MultiloadExportRecord *rec = &ex->records[count % MULTILOAD_EXPORT_RECORDS];
+
+	n_values = MIN(n_values, MULTILOAD_EXPORT_MAX_VALUES);
+	n_scales = MIN(n_scales, MULTILOAD_EXPORT_MAX_SCALES);
+
+	__atomic_store_n(&rec->seq, count*2 + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	rec->time = time;
+	rec->graph_id = graph_id;
+	rec->n_values = n_values;
+	rec->n_scales = n_scales;
+	memcpy(rec->values, values, n_values * sizeof(gint32));
+	memcpy(rec->scales, scales, n_scales * sizeof(gfloat));
+
+	__atomic_store_n(&rec->seq, count*2 + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&ex->header->write_count, count + 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+#ifndef __MULTILOAD_EXPORT_H__
+#define __MULTILOAD_EXPORT_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+/* Samples of all graphs are written to a ring of fixed size records, in a
+ * file under the user runtime dir ($XDG_RUNTIME_DIR/multiload-ng/export-N,
+ * N being the first free slot). Other programs can mmap it read-only.
+ *
+ * Readers take write_count from the header: the most recent record is at
+ * (write_count-1) % n_records. A record is consistent if its seq is even and
+ * did not change while copying it (seqlock). All integers are in host order.
+ *
+ * Raw value of series i is values[i] / 65536.0 * scales[i / (n_values/n_scales)],
+ * in graph units (per interval for rates). A zero scale means that values
+ * are fractions of the whole (e.g. processor usage). */
+
+#define MULTILOAD_EXPORT_MAGIC 0x58454c4d // "MLEX"
+#define MULTILOAD_EXPORT_VERSION 1
+#define MULTILOAD_EXPORT_RECORDS 1024
+#define MULTILOAD_EXPORT_MAX_VALUES 48
+#define MULTILOAD_EXPORT_MAX_SCALES 8
+
+typedef struct {
+	guint32 magic;
+	guint32 version;
+	guint32 record_size;
+	guint32 n_records;
+	guint64 write_count;	// records written since creation
+} MultiloadExportHeader;
+
+typedef struct {
+	guint64 seq;			// odd while the record is being written
+	gint64 time;			// monotonic time (CLOCK_MONOTONIC), in microseconds
+	guint32 graph_id;
+	guint32 n_values;
+	guint32 n_scales;
+	guint32 reserved;
+	gint32 values[MULTILOAD_EXPORT_MAX_VALUES];	// 16.16 fixed point fraction of scale
+	gfloat scales[MULTILOAD_EXPORT_MAX_SCALES];
+} MultiloadExportRecord;
+
+typedef struct {
+	MultiloadExportHeader *header;
+	MultiloadExportRecord *records;
+	gchar *filename;
+	gint fd;
+} MultiloadExport;
+
+
+G_GNUC_INTERNAL MultiloadExport*
+multiload_export_new ();
+G_GNUC_INTERNAL void
+multiload_export_free (MultiloadExport *ex);
+G_GNUC_INTERNAL void
+multiload_export_write (MultiloadExport *ex, guint graph_id, gint64 time, const gint32 *values, guint n_values, const gfloat *scales, guint n_scales);
+
+G_END_DECLS
+
+#endif /* __MULTILOAD_EXPORT_H__ */
@@ -25,13 +25,6 @@
 
 #include "filter.h"
 
-/* Requirements for filter separators:
- * 1. Must characters/sequences that never appear in filter elements.
- *    By now, filter elements are all files in /sys or /dev.
- * 2. To play safe, longer sequences can be used.
- * 3. Must not contain newlines or invalid UTF-8 sequences. */
-#define MULTILOAD_FILTER_SEPARATOR "|"
-
 
 MultiloadFilter*
 multiload_filter_new()
@@ -45,7 +38,7 @@ multiload_filter_new()
 }
 
 MultiloadFilter*
-multiload_filter_new_from_existing(gchar *existing)
+multiload_filter_new_from_existing(const gchar *existing)
 {
 	guint i;
 	MultiloadFilter *filter = multiload_filter_new();
@@ -110,7 +103,7 @@ multiload_filter_append_with_state(MultiloadFilter *filter, char *data, Multiloa
 }
 
 void
-multiload_filter_import_existing(MultiloadFilter *filter, char *existing)
+multiload_filter_import_existing(MultiloadFilter *filter, const char *existing)
 {
 	g_assert(filter != NULL);
 
@@ -137,7 +130,7 @@ multiload_filter_import_existing(MultiloadFilter *filter, char *existing)
 			continue;
 
 		j = multiload_filter_append(filter, split[i]);
-		e = multiload_filter_get_element(filter, j-1);
+		e = multiload_filter_get_element(filter, j);
 		e->state = MULTILOAD_FILTER_STATE_ABSENT;
 	}
 
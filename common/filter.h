@@ -28,6 +28,13 @@
 
 G_BEGIN_DECLS
 
+/* Requirements for filter separators:
+ * 1. Must characters/sequences that never appear in filter elements.
+ *    By now, filter elements are all files in /sys or /dev.
+ * 2. To play safe, longer sequences can be used.
+ * 3. Must not contain newlines or invalid UTF-8 sequences. */
+#define MULTILOAD_FILTER_SEPARATOR "|"
+
 typedef enum {
 	MULTILOAD_FILTER_STATE_UNSELECTED,
 	MULTILOAD_FILTER_STATE_SELECTED,
@@ -50,7 +57,7 @@ G_GNUC_INTERNAL MultiloadFilter*
 multiload_filter_new();
 
 G_GNUC_INTERNAL MultiloadFilter*
-multiload_filter_new_from_existing(gchar *existing);
+multiload_filter_new_from_existing(const gchar *existing);
 
 G_GNUC_INTERNAL guint
 multiload_filter_get_length(MultiloadFilter *filter);
@@ -65,7 +72,7 @@ G_GNUC_INTERNAL guint
 multiload_filter_append_with_state(MultiloadFilter *filter, char *data, MultiloadFilterElementState state);
 
 G_GNUC_INTERNAL void
-multiload_filter_import_existing(MultiloadFilter *filter, char *existing);
+multiload_filter_import_existing(MultiloadFilter *filter, const char *existing);
 
 void
 multiload_filter_export(MultiloadFilter *filter, char *buf, size_t len);
@@ -29,7 +29,6 @@
 #include "graph-data.h"
 #include "autoscaler.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 #define B(xd) ((bat_info*)(xd->battery))
@@ -186,12 +185,12 @@ battery_clear (bat_info **b)
 
 
 void
-multiload_graph_bat_init (LoadGraph *g, BatteryData *xd)
+multiload_graph_bat_init (MultiloadCollector *c, BatteryData *xd)
 {
 	struct dirent *dirent;
 
 	// check if /sys node exists, otherwise means no battery support or no battery at all
-	DIR *dir = opendir(PATH_POWER_SUPPLY);
+	DIR *dir = info_file_opendir(PATH_POWER_SUPPLY);
 	if (dir == NULL)
 		return;
 
@@ -210,7 +209,7 @@ multiload_graph_bat_init (LoadGraph *g, BatteryData *xd)
 }
 
 void
-multiload_graph_bat_get_data (int Maximum, int data [3], LoadGraph *g, BatteryData *xd, gboolean first_call)
+multiload_graph_bat_get_data (int Maximum, int data [3], MultiloadCollector *c, BatteryData *xd, gboolean first_call)
 {
 	memset(data, 0, 3*sizeof(data[0]));
 
@@ -235,19 +234,19 @@ multiload_graph_bat_get_data (int Maximum, int data [3], LoadGraph *g, BatteryDa
 
 
 void
-multiload_graph_bat_cmdline_output (LoadGraph *g, BatteryData *xd)
+multiload_graph_bat_cmdline_output (MultiloadCollector *c, BatteryData *xd)
 {
 	bat_info *battery = B(xd);
 
 	if (battery == NULL)
 		return;
 
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%.1f", battery->percentage);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%.1f", battery->percentage);
 }
 
 
 void
-multiload_graph_bat_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, BatteryData *xd, gint style)
+multiload_graph_bat_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, BatteryData *xd, gint style)
 {
 	bat_info *battery = B(xd);
 
@@ -27,7 +27,7 @@
 
 #include "graph-data.h"
 #include "info-file.h"
-#include "preferences.h"
+#include "proc-stat.h"
 #include "util.h"
 
 
@@ -44,14 +44,13 @@ enum {
 #define PATH_CPUFREQ "/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor"
 #define PATH_UPTIME "/proc/uptime"
 #define PATH_CPUINFO "/proc/cpuinfo"
-#define PATH_STAT "/proc/stat"
 
 
 static gboolean have_cpufreq;
 
 
 void
-multiload_graph_cpu_init (LoadGraph *g, CpuData *xd)
+multiload_graph_cpu_init (MultiloadCollector *c, CpuData *xd)
 {
 	info_file_read_key_string_s (PATH_CPUINFO, "model name", xd->cpu0_name, sizeof(xd->cpu0_name), NULL);
 
@@ -65,17 +64,61 @@ multiload_graph_cpu_init (LoadGraph *g, CpuData *xd)
 	}
 }
 
+/* cgroup scope: cpu.stat only reports user and system time, as a fraction
+ * of the CPU time available to the cgroup (limited by cpu.max) */
+static void
+multiload_graph_cpu_get_data_cgroup (int Maximum, int data [4], MultiloadCollector *c, CpuData *xd, gboolean first_call)
+{
+	MultiloadCgroupCpuStat stat;
+	gint64 now = g_get_monotonic_time();
+	gdouble cpus, capacity;
+	guint64 usage, user, system;
+
+	if (!multiload_cgroup_read_cpu(c->cgroup, &stat)) {
+		memset(data, 0, 4*sizeof(data[0]));
+		xd->user = xd->nice = xd->system = xd->iowait = xd->total_use = 0;
+		xd->cgroup_last_time = 0;
+		return;
+	}
+
+	if (G_LIKELY(!first_call) && xd->cgroup_last_time > 0 && now > xd->cgroup_last_time) {
+		cpus = MAX(xd->num_cpu, 1);
+		if (stat.quota > 0 && stat.quota < cpus)
+			cpus = stat.quota;
+		capacity = cpus * (now - xd->cgroup_last_time);
+
+		usage	= stat.usage_usec	- xd->cgroup_last[0];
+		user	= stat.user_usec	- xd->cgroup_last[1];
+		system	= stat.system_usec	- xd->cgroup_last[2];
+
+		xd->user			= MIN(100.0, 100.0 * user / capacity);
+		xd->nice			= 0;
+		xd->system			= MIN(100.0, 100.0 * system / capacity);
+		xd->iowait			= 0;
+		xd->total_use		= MIN(100.0, 100.0 * usage / capacity);
+
+		data[CPU_USER]		= rint (Maximum * xd->user / 100.0);
+		data[CPU_NICE]		= 0;
+		data[CPU_SYS]		= rint (Maximum * xd->system / 100.0);
+		data[CPU_IOWAIT]	= 0;
+	}
+
+	xd->cgroup_last[0] = stat.usage_usec;
+	xd->cgroup_last[1] = stat.user_usec;
+	xd->cgroup_last[2] = stat.system_usec;
+	xd->cgroup_last_time = now;
+}
+
 void
-multiload_graph_cpu_get_data (int Maximum, int data [4], LoadGraph *g, CpuData *xd, gboolean first_call)
+multiload_graph_cpu_get_data (int Maximum, int data [4], MultiloadCollector *c, CpuData *xd, gboolean first_call)
 {
-	guint64 irq, softirq, total;
+	MultiloadProcStat stat;
+	guint64 total;
 	guint i;
 
 	guint64 time[CPU_MAX];
 	guint64 diff[CPU_MAX];
 
-	size_t n;
-
 	info_file_read_key_double (PATH_CPUINFO, "cpu MHz", &xd->cpu0_mhz, 1);
 	info_file_read_double (PATH_UPTIME, &xd->uptime, 1);
 
@@ -84,13 +127,25 @@ multiload_graph_cpu_get_data (int Maximum, int data [4], LoadGraph *g, CpuData *
 		have_cpufreq = FALSE;
 	}
 
-	// CPU stats
-	FILE *f = info_file_required_fopen(PATH_STAT, "r");
-	n = fscanf(f, "cpu %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT,
-				time+CPU_USER, time+CPU_NICE, time+CPU_SYS, time+CPU_IDLE, time+CPU_IOWAIT, &irq, &softirq);
-	fclose(f);
-	g_assert_cmpuint(n, ==, 7);
-	time[CPU_IOWAIT] += irq+softirq;
+	// pressure is only shown in tooltip
+	if (c->tooltip_update)
+		multiload_cgroup_read_pressure(c->cgroup, CGROUP_RESOURCE_CPU, &xd->pressure);
+
+	if (c->cgroup != NULL) {
+		multiload_graph_cpu_get_data_cgroup(Maximum, data, c, xd, first_call);
+		return;
+	}
+
+	// CPU stats (same read also feeds the scheduler graph)
+	if (!multiload_proc_stat_read(&stat, 0)) {
+		memset(data, 0, 4*sizeof(data[0]));
+		return;
+	}
+	time[CPU_USER]		= stat.cpu[PROC_STAT_CPU_USER];
+	time[CPU_NICE]		= stat.cpu[PROC_STAT_CPU_NICE];
+	time[CPU_SYS]		= stat.cpu[PROC_STAT_CPU_SYSTEM];
+	time[CPU_IOWAIT]	= stat.cpu[PROC_STAT_CPU_IOWAIT] + stat.cpu[PROC_STAT_CPU_IRQ] + stat.cpu[PROC_STAT_CPU_SOFTIRQ];
+	time[CPU_IDLE]		= stat.cpu[PROC_STAT_CPU_IDLE];
 
 	if (G_LIKELY(!first_call)) { // cannot calculate diff on first call
 		for (i=0, total=0; i<CPU_MAX; i++) {
@@ -113,17 +168,17 @@ multiload_graph_cpu_get_data (int Maximum, int data [4], LoadGraph *g, CpuData *
 
 
 void
-multiload_graph_cpu_cmdline_output (LoadGraph *g, CpuData *xd)
+multiload_graph_cpu_cmdline_output (MultiloadCollector *c, CpuData *xd)
 {
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%.03f", xd->user);
-	g_snprintf(g->output_str[1], sizeof(g->output_str[1]), "%.03f", xd->nice);
-	g_snprintf(g->output_str[2], sizeof(g->output_str[2]), "%.03f", xd->system);
-	g_snprintf(g->output_str[3], sizeof(g->output_str[3]), "%.03f", xd->iowait);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%.03f", xd->user);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%.03f", xd->nice);
+	g_snprintf(c->output_str[2], sizeof(c->output_str[2]), "%.03f", xd->system);
+	g_snprintf(c->output_str[3], sizeof(c->output_str[3]), "%.03f", xd->iowait);
 }
 
 
 void
-multiload_graph_cpu_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, CpuData *xd, gint style)
+multiload_graph_cpu_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, CpuData *xd, gint style)
 {
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 		gchar *uptime = format_time_duration(xd->uptime);
@@ -140,6 +195,11 @@ multiload_graph_cpu_tooltip_update (char *buf_title, size_t len_title, char *buf
 											xd->user, xd->nice, xd->system, xd->iowait, xd->total_use,
 											uptime);
 		g_free(uptime);
+
+		if (c->cgroup != NULL)
+			str_append_printf(buf_text, len_text, _("\nControl group: %s"), c->cgroup->scope);
+		if (xd->pressure.valid)
+			str_append_printf(buf_text, len_text, _("\nPressure: %.1f%% some, %.1f%% full"), xd->pressure.some_avg10, xd->pressure.full_avg10);
 	} else {
 		g_snprintf(buf_text, len_text, "%.1f%%", xd->total_use);
 	}
@@ -23,6 +23,7 @@
 #define __GRAPH_DATA_H__
 
 #include "autoscaler.h"
+#include "cgroup.h"
 #include "filter.h"
 
 
@@ -44,17 +45,58 @@ typedef struct _CpuData {
 	// use oversized buffers (just to be sure)
 	gchar cpu0_governor[32];
 	double cpu0_mhz;
+
+	// cgroup scope
+	guint64 cgroup_last[3];
+	gint64 cgroup_last_time;
+	MultiloadPressure pressure;
 } CpuData;
 
 typedef struct _MemoryData {
 	guint64 user;
 	guint64 buffers;
 	guint64 cache;
+	guint64 dirty;		// dirty + writeback
+	guint64 hugepages;
 	guint64 total;
 
+	// not drawn, shown in tooltip
+	guint64 available;
+	guint64 shmem;
+	guint64 slab_reclaimable;
+	guint64 anon;
+
 	gboolean procps_compliant;
+	gboolean show_dirty;
+	gboolean show_hugepages;
+	MultiloadPressure pressure;
 } MemoryData;
 
+enum {
+	NET_EXT_RX_PACKETS,
+	NET_EXT_TX_PACKETS,
+	NET_EXT_RX_ERRORS,
+	NET_EXT_TX_ERRORS,
+	NET_EXT_RX_DROPS,
+	NET_EXT_TX_DROPS,
+	NET_EXT_TCP_RETRANS,
+	NET_EXT_TCP_OUT,
+
+	NET_EXT_MAX
+};
+
+// state of a single network interface, for per-interface strips
+typedef struct {
+	gchar name[32];
+	guint64 last_rx;
+	guint64 last_tx;
+	guint64 rx_delta;	// bytes in last interval
+	guint64 tx_delta;
+	guint64 sample;		// last sample the interface was seen in
+	guint64 link_speed;	// Mbit/s, 0 when unknown
+	guint link_generation;
+} NetIface;
+
 typedef struct _NetData {
 	guint64 last [3];
 	AutoScaler scaler;
@@ -64,11 +106,46 @@ typedef struct _NetData {
 	guint64 local_speed;
 
 	gchar ifaces[64];
+
+	// extended mode: packets, errors, drops and TCP retransmits
+	gboolean show_extended;
+	guint64 last_ext[NET_EXT_MAX];
+	guint64 ext_rate[NET_EXT_MAX];	// per second
+	gint snmp_fd;
+
+	// per-interface mode: one strip for each monitored interface
+	gboolean show_per_iface;
+	NetIface *iface;		// indexed by ifindex, grown when needed
+	guint iface_len;
+	guint64 sample;
+	guint strip_ifindex[MAX_STRIPS];
+	guint strip_count;
+	AutoScaler strip_scaler[MAX_STRIPS];
+
+	// scale against link speed of monitored interfaces instead of autoscaler
+	gboolean scale_link_speed;
+	gint link_fd;			// netlink socket, reports link changes
+	guint link_generation;
+	guint64 link_capacity;	// Mbit/s, sum of monitored interfaces
 } NetData;
 
 typedef struct _SwapData {
 	guint64 used;
 	guint64 total;
+
+	guint64 last_in;
+	guint64 last_out;
+	AutoScaler scaler;
+	glong page_size;
+
+	guint64 in_speed;
+	guint64 out_speed;
+	gboolean show_activity;
+
+	// compressed swap (zram devices and zswap pool), only read for tooltip
+	guint64 compressed_orig;
+	guint64 compressed_size;
+	gdouble compression_ratio;
 } SwapData;
 
 typedef struct _LoadData {
@@ -91,6 +168,7 @@ typedef struct _DiskData {
 	guint64 write_speed;
 
 	gchar partitions[128];
+	MultiloadPressure pressure;
 } DiskData;
 
 typedef struct _TemperatureData {
@@ -113,85 +191,165 @@ typedef struct _ParametricData {
 	AutoScaler scaler;
 } ParametricData;
 
+enum {
+	VM_PGFAULT,
+	VM_PGMAJFAULT,
+	VM_PGSCAN_KSWAPD,
+	VM_PGSCAN_DIRECT,
+	VM_PGSTEAL_KSWAPD,
+	VM_PGSTEAL_DIRECT,
+	VM_ALLOCSTALL,
+	VM_COMPACT_STALL,
+
+	VM_COUNTER_MAX
+};
+
+typedef struct _VmData {
+	gint fd;	// /proc/vmstat, kept open between reads
+
+	guint64 last[VM_COUNTER_MAX];
+	guint64 rate[VM_COUNTER_MAX];	// per second
+	AutoScaler scaler;
+} VmData;
+
+enum {
+	SCHED_SOFTIRQ_HI,
+	SCHED_SOFTIRQ_TIMER,
+	SCHED_SOFTIRQ_NET_TX,
+	SCHED_SOFTIRQ_NET_RX,
+	SCHED_SOFTIRQ_BLOCK,
+	SCHED_SOFTIRQ_IRQ_POLL,
+	SCHED_SOFTIRQ_TASKLET,
+	SCHED_SOFTIRQ_SCHED,
+	SCHED_SOFTIRQ_HRTIMER,
+	SCHED_SOFTIRQ_RCU,
+
+	SCHED_SOFTIRQ_MAX
+};
+
+typedef struct _SchedData {
+	guint64 last_ctxt;
+	guint64 last_intr;
+	guint64 last_softirq;
+	gint64 last_time;
+	AutoScaler scaler;
+
+	// per second
+	guint64 ctxt_rate;
+	guint64 intr_rate;
+	guint64 softirq_rate;
+
+	guint procs_running;
+	guint procs_blocked;
+
+	// per-class breakdown from /proc/softirqs, only read when enabled
+	gboolean show_softirqs;
+	guint64 last_softirq_class[SCHED_SOFTIRQ_MAX];
+	gint64 last_softirq_class_time;
+	guint64 softirq_class_rate[SCHED_SOFTIRQ_MAX];
+} SchedData;
+
 
 G_GNUC_INTERNAL void
-multiload_graph_cpu_init (LoadGraph *g, CpuData *xd);
+multiload_graph_cpu_init (MultiloadCollector *c, CpuData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_cpu_get_data (int Maximum, int data [5], LoadGraph *g, CpuData *xd, gboolean first_call);
+multiload_graph_cpu_get_data (int Maximum, int data [5], MultiloadCollector *c, CpuData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_cpu_cmdline_output (LoadGraph *g, CpuData *xd);
+multiload_graph_cpu_cmdline_output (MultiloadCollector *c, CpuData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_cpu_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, CpuData *xd, gint style);
+multiload_graph_cpu_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, CpuData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_mem_get_data (int Maximum, int data [4], LoadGraph *g, MemoryData *xd, gboolean first_call);
+multiload_graph_mem_get_data (int Maximum, int data [5], MultiloadCollector *c, MemoryData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_mem_cmdline_output (LoadGraph *g, MemoryData *xd);
+multiload_graph_mem_cmdline_output (MultiloadCollector *c, MemoryData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_mem_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, MemoryData *xd, gint style);
+multiload_graph_mem_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, MemoryData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_net_init (LoadGraph *g, NetData *xd);
+multiload_graph_net_init (MultiloadCollector *c, NetData *xd);
+G_GNUC_INTERNAL void
+multiload_graph_net_free (MultiloadCollector *c, NetData *xd);
 G_GNUC_INTERNAL MultiloadFilter *
-multiload_graph_net_get_filter (LoadGraph *g, NetData *xd);
+multiload_graph_net_get_filter (MultiloadCollector *c, NetData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_net_get_data (int Maximum, int data [4], LoadGraph *g, NetData *xd, gboolean first_call);
+multiload_graph_net_get_data (int Maximum, int data [4], MultiloadCollector *c, NetData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_net_cmdline_output (LoadGraph *g, NetData *xd);
+multiload_graph_net_cmdline_output (MultiloadCollector *c, NetData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_net_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, NetData *xd, gint style);
+multiload_graph_net_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, NetData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_swap_get_data (int Maximum, int data [2], LoadGraph *g, SwapData *xd, gboolean first_call);
+multiload_graph_swap_init (MultiloadCollector *c, SwapData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_swap_cmdline_output (LoadGraph *g, SwapData *xd);
+multiload_graph_swap_get_data (int Maximum, int data [3], MultiloadCollector *c, SwapData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_swap_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, SwapData *xd, gint style);
+multiload_graph_swap_cmdline_output (MultiloadCollector *c, SwapData *xd);
+G_GNUC_INTERNAL void
+multiload_graph_swap_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, SwapData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_load_init (LoadGraph *g, LoadData *xd);
+multiload_graph_load_init (MultiloadCollector *c, LoadData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_load_get_data (int Maximum, int data [2], LoadGraph *g, LoadData *xd, gboolean first_call);
+multiload_graph_load_get_data (int Maximum, int data [2], MultiloadCollector *c, LoadData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_load_cmdline_output (LoadGraph *g, LoadData *xd);
+multiload_graph_load_cmdline_output (MultiloadCollector *c, LoadData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_load_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, LoadData *xd, gint style);
+multiload_graph_load_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, LoadData *xd, gint style);
 
 G_GNUC_INTERNAL MultiloadFilter *
-multiload_graph_disk_get_filter (LoadGraph *g, DiskData *xd);
+multiload_graph_disk_get_filter (MultiloadCollector *c, DiskData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_disk_get_data (int Maximum, int data [3], LoadGraph *g, DiskData *xd, gboolean first_call);
+multiload_graph_disk_get_data (int Maximum, int data [3], MultiloadCollector *c, DiskData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_disk_cmdline_output (LoadGraph *g, DiskData *xd);
+multiload_graph_disk_cmdline_output (MultiloadCollector *c, DiskData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_disk_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, DiskData *xd, gint style);
+multiload_graph_disk_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, DiskData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_temp_init (LoadGraph *g, TemperatureData *xd);
+multiload_graph_temp_init (MultiloadCollector *c, TemperatureData *xd);
 G_GNUC_INTERNAL MultiloadFilter *
-multiload_graph_temp_get_filter (LoadGraph *g, TemperatureData *xd);
+multiload_graph_temp_get_filter (MultiloadCollector *c, TemperatureData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_temp_get_data (int Maximum, int data [2], LoadGraph *g, TemperatureData *xd, gboolean first_call);
+multiload_graph_temp_get_data (int Maximum, int data [2], MultiloadCollector *c, TemperatureData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_temp_cmdline_output (LoadGraph *g, TemperatureData *xd);
+multiload_graph_temp_cmdline_output (MultiloadCollector *c, TemperatureData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_temp_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, TemperatureData *xd, gint style);
+multiload_graph_temp_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, TemperatureData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_bat_init (LoadGraph *g, BatteryData *xd);
+multiload_graph_bat_init (MultiloadCollector *c, BatteryData *xd);
+G_GNUC_INTERNAL void
+multiload_graph_bat_get_data (int Maximum, int data [3], MultiloadCollector *c, BatteryData *xd, gboolean first_call);
+G_GNUC_INTERNAL void
+multiload_graph_bat_cmdline_output (MultiloadCollector *c, BatteryData *xd);
+G_GNUC_INTERNAL void
+multiload_graph_bat_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, BatteryData *xd, gint style);
+
+G_GNUC_INTERNAL void
+multiload_graph_parm_get_data (int Maximum, int data[4], MultiloadCollector *c, ParametricData *xd, gboolean first_call);
+G_GNUC_INTERNAL void
+multiload_graph_parm_cmdline_output (MultiloadCollector *c, ParametricData *xd);
+G_GNUC_INTERNAL void
+multiload_graph_parm_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, ParametricData *xd, gint style);
+
+G_GNUC_INTERNAL void
+multiload_graph_vm_init (MultiloadCollector *c, VmData *xd);
+G_GNUC_INTERNAL void
+multiload_graph_vm_free (MultiloadCollector *c, VmData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_bat_get_data (int Maximum, int data [3], LoadGraph *g, BatteryData *xd, gboolean first_call);
+multiload_graph_vm_get_data (int Maximum, int data [2], MultiloadCollector *c, VmData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_bat_cmdline_output (LoadGraph *g, BatteryData *xd);
+multiload_graph_vm_cmdline_output (MultiloadCollector *c, VmData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_bat_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, BatteryData *xd, gint style);
+multiload_graph_vm_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, VmData *xd, gint style);
 
 G_GNUC_INTERNAL void
-multiload_graph_parm_get_data (int Maximum, int data[4], LoadGraph *g, ParametricData *xd, gboolean first_call);
+multiload_graph_sched_get_data (int Maximum, int data [2], MultiloadCollector *c, SchedData *xd, gboolean first_call);
 G_GNUC_INTERNAL void
-multiload_graph_parm_cmdline_output (LoadGraph *g, ParametricData *xd);
+multiload_graph_sched_cmdline_output (MultiloadCollector *c, SchedData *xd);
 G_GNUC_INTERNAL void
-multiload_graph_parm_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, ParametricData *xd, gint style);
+multiload_graph_sched_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, SchedData *xd, gint style);
 
 G_END_DECLS
 
@@ -29,7 +29,6 @@
 #include "graph-data.h"
 #include "autoscaler.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 
@@ -37,7 +36,7 @@ static const char *fstype_ignore_list[] = { "rootfs", "smbfs", "nfs", "cifs", "f
 
 
 MultiloadFilter *
-multiload_graph_disk_get_filter (LoadGraph *g, DiskData *xd)
+multiload_graph_disk_get_filter (MultiloadCollector *c, DiskData *xd)
 {
 	char *buf = NULL;
 	size_t n = 0;
@@ -72,10 +71,11 @@ multiload_graph_disk_get_filter (LoadGraph *g, DiskData *xd)
 		else
 			g_snprintf(sysfs_path, PATH_MAX, "/sys/block/%s/stat", device);
 
-		if (access(sysfs_path, R_OK) != 0)
+		char real_path[PATH_MAX];
+		if (access(info_file_path(sysfs_path, real_path), R_OK) != 0)
 			continue;
 
-		gchar *size = format_size_for_display(blocks*1024, g->multiload->size_format_iec);
+		gchar *size = format_size_for_display(blocks*1024, c->size_format_iec);
 		g_snprintf(label, sizeof(label), "%s (%s)", device, size);
 		g_free(size);
 
@@ -85,35 +85,32 @@ multiload_graph_disk_get_filter (LoadGraph *g, DiskData *xd)
 	g_free(buf);
 	fclose(f);
 
-	multiload_filter_import_existing(filter, g->config->filter);
+	multiload_filter_import_existing(filter, c->filter);
 
 	return filter;
 }
 
 
-void
-multiload_graph_disk_get_data (int Maximum, int data [2], LoadGraph *g, DiskData *xd, gboolean first_call)
+/* Sums sectors read/written by mounted block devices (whole system scope) */
+static void
+multiload_graph_disk_read_mounts (MultiloadCollector *c, DiskData *xd, guint64 *read_total, guint64 *write_total)
 {
 	FILE *f_mntent;
 	FILE *f_stat;
 	struct mntent *mnt;
 
 	guint i;
-	int max;
 
 	char sysfs_path[PATH_MAX];
 	char *device;
 	char prefix[20];
 	guint64 read, write;
-	guint64 read_total = 0, write_total = 0;
-	guint64 readdiff, writediff;
 
+	xd->partitions[0] = '\0';
 
-	if ((f_mntent = setmntent(MOUNTED, "r")) == NULL)
+	if ((f_mntent = setmntent(info_file_path(MOUNTED, sysfs_path), "r")) == NULL)
 		return;
 
-	xd->partitions[0] = '\0';
-
 	// loop through mountpoints
 	while ((mnt = getmntent(f_mntent)) != NULL) {
 
@@ -145,8 +142,8 @@ multiload_graph_disk_get_data (int Maximum, int data [2], LoadGraph *g, DiskData
 		}
 
 		// filter
-		if (g->config->filter_enable) {
-			MultiloadFilter *filter = multiload_filter_new_from_existing(g->config->filter);
+		if (c->filter_enable) {
+			MultiloadFilter *filter = multiload_filter_new_from_existing(c->filter);
 			for (i=0, ignore=TRUE; i<multiload_filter_get_length(filter); i++) {
 				if (strcmp(multiload_filter_get_element_data(filter,i), device) == 0) {
 					ignore = FALSE;
@@ -169,7 +166,7 @@ multiload_graph_disk_get_data (int Maximum, int data [2], LoadGraph *g, DiskData
 			g_snprintf(sysfs_path, PATH_MAX, "/sys/block/%s/stat", device);
 
 		// read data from sysfs
-		f_stat = fopen(sysfs_path, "r");
+		f_stat = info_file_fopen(sysfs_path, "r");
 		if (f_stat == NULL)
 			continue;
 		int result = fscanf(f_stat, "%*u %*u %"G_GUINT64_FORMAT" %*u %*u %*u %"G_GUINT64_FORMAT" %*u", &read, &write);
@@ -178,14 +175,45 @@ multiload_graph_disk_get_data (int Maximum, int data [2], LoadGraph *g, DiskData
 			continue;
 
 		// data gathered - add to totals
-		read_total += read;
-		write_total += write;
+		*read_total += read;
+		*write_total += write;
 
+		if (xd->partitions[0] != '\0')
+			g_strlcat (xd->partitions, ", ", sizeof(xd->partitions));
 		g_strlcat (xd->partitions, device, sizeof(xd->partitions));
-		g_strlcat (xd->partitions, ", ", sizeof(xd->partitions));
 	}
 	endmntent(f_mntent);
-	xd->partitions[strlen(xd->partitions)-2] = 0;
+}
+
+/* cgroup scope: io.stat counts bytes, convert them to sectors like sysfs */
+static void
+multiload_graph_disk_read_cgroup (MultiloadCollector *c, DiskData *xd, guint64 *read_total, guint64 *write_total)
+{
+	MultiloadCgroupIoStat stat;
+
+	multiload_cgroup_read_io(c->cgroup, c->filter_enable ? c->filter : NULL, &stat);
+
+	*read_total = stat.rbytes / 512;
+	*write_total = stat.wbytes / 512;
+	g_strlcpy(xd->partitions, stat.devices, sizeof(xd->partitions));
+}
+
+void
+multiload_graph_disk_get_data (int Maximum, int data [2], MultiloadCollector *c, DiskData *xd, gboolean first_call)
+{
+	int max;
+
+	guint64 read_total = 0, write_total = 0;
+	guint64 readdiff, writediff;
+
+	// pressure is only shown in tooltip
+	if (c->tooltip_update)
+		multiload_cgroup_read_pressure(c->cgroup, CGROUP_RESOURCE_IO, &xd->pressure);
+
+	if (c->cgroup != NULL)
+		multiload_graph_disk_read_cgroup(c, xd, &read_total, &write_total);
+	else
+		multiload_graph_disk_read_mounts(c, xd, &read_total, &write_total);
 
 	readdiff  = read_total  - xd->last_read;
 	writediff = write_total - xd->last_write;
@@ -194,7 +222,7 @@ multiload_graph_disk_get_data (int Maximum, int data [2], LoadGraph *g, DiskData
 	xd->last_write = write_total;
 
 	if (G_LIKELY(!first_call)) { // cannot calculate diff on first call
-		max = autoscaler_get_max(&xd->scaler, g, readdiff + writediff);
+		max = autoscaler_get_max(&xd->scaler, c, readdiff + writediff);
 
 		if (max == 0) {
 			memset(data, 0, 4*sizeof(data[0]));
@@ -204,25 +232,25 @@ multiload_graph_disk_get_data (int Maximum, int data [2], LoadGraph *g, DiskData
 		}
 
 		// read/write are relative to standard linux sectors (512 bytes, fixed)
-		xd->read_speed  = calculate_speed(readdiff  * 512, g->config->interval);
-		xd->write_speed = calculate_speed(writediff * 512, g->config->interval);
+		xd->read_speed  = calculate_speed(readdiff  * 512, c->interval);
+		xd->write_speed = calculate_speed(writediff * 512, c->interval);
 	}
 }
 
 
 void
-multiload_graph_disk_cmdline_output (LoadGraph *g, DiskData *xd)
+multiload_graph_disk_cmdline_output (MultiloadCollector *c, DiskData *xd)
 {
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%"G_GUINT64_FORMAT, xd->read_speed);
-	g_snprintf(g->output_str[1], sizeof(g->output_str[1]), "%"G_GUINT64_FORMAT, xd->write_speed);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%"G_GUINT64_FORMAT, xd->read_speed);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%"G_GUINT64_FORMAT, xd->write_speed);
 }
 
 
 void
-multiload_graph_disk_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, DiskData *xd, gint style)
+multiload_graph_disk_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, DiskData *xd, gint style)
 {
-	gchar *disk_read = format_rate_for_display(xd->read_speed, g->multiload->size_format_iec);
-	gchar *disk_write = format_rate_for_display(xd->write_speed, g->multiload->size_format_iec);
+	gchar *disk_read = format_rate_for_display(xd->read_speed, c->size_format_iec);
+	gchar *disk_write = format_rate_for_display(xd->write_speed, c->size_format_iec);
 
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 		g_snprintf(buf_text, len_text, _(	"Monitored partitions: %s\n"
@@ -230,6 +258,11 @@ multiload_graph_disk_tooltip_update (char *buf_title, size_t len_title, char *bu
 											"Read: %s\n"
 											"Write: %s"),
 											xd->partitions, disk_read, disk_write);
+
+		if (c->cgroup != NULL)
+			str_append_printf(buf_text, len_text, _("\nControl group: %s"), c->cgroup->scope);
+		if (xd->pressure.valid)
+			str_append_printf(buf_text, len_text, _("\nPressure: %.1f%% some, %.1f%% full"), xd->pressure.some_avg10, xd->pressure.full_avg10);
 	} else {
 		g_snprintf(buf_text, len_text, "\xe2\xac\x86%s \xe2\xac\x87%s", disk_read, disk_write);
 	}
@@ -28,7 +28,6 @@
 
 #include "graph-data.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 enum {
@@ -42,7 +41,7 @@ enum {
 
 
 void
-multiload_graph_load_init (LoadGraph *g, LoadData *xd)
+multiload_graph_load_init (MultiloadCollector *c, LoadData *xd)
 {
 	struct utsname un;
 	if (0 == uname(&un)) {
@@ -53,21 +52,25 @@ multiload_graph_load_init (LoadGraph *g, LoadData *xd)
 }
 
 void
-multiload_graph_load_get_data (int Maximum, int data [1], LoadGraph *g, LoadData *xd, gboolean first_call)
+multiload_graph_load_get_data (int Maximum, int data [1], MultiloadCollector *c, LoadData *xd, gboolean first_call)
 {
-	int n;
+	gchar buf[128];
+	gchar *p;
+	int i, n;
 
-	// load average
-	n = getloadavg(xd->loadavg, 3);
-	g_assert_cmpint(n, >=, 0);
+	/* Load average and threads stats. This file is parsed rather than calling
+	 * getloadavg(), that always reads the live system. Decimal separator is
+	 * always a dot, so parsing does not depend on the locale. */
+	if (!info_file_read_string_s(PATH_LOADAVG, buf, sizeof(buf), NULL))
+		g_assert_not_reached();
 
-	// threads stats
-	FILE *f = info_file_required_fopen(PATH_LOADAVG, "r");
-	n = fscanf(f, "%*s %*s %*s %u/%u", &xd->proc_active, &xd->proc_count);
-	fclose(f);
+	p = buf;
+	for (i=0; i<3; i++)
+		xd->loadavg[i] = g_ascii_strtod(p, &p);
+	n = sscanf(p, "%u/%u", &xd->proc_active, &xd->proc_count);
 	g_assert_cmpint(n, ==, 2);
 
-	int max = autoscaler_get_max(&xd->scaler, g, rint(xd->loadavg[LOADAVG_1]));
+	int max = autoscaler_get_max(&xd->scaler, c, rint(xd->loadavg[LOADAVG_1]));
 	if (max == 0) {
 		memset(data, 0, 4*sizeof(data[0]));
 	} else {
@@ -76,16 +79,16 @@ multiload_graph_load_get_data (int Maximum, int data [1], LoadGraph *g, LoadData
 }
 
 void
-multiload_graph_load_cmdline_output (LoadGraph *g, LoadData *xd)
+multiload_graph_load_cmdline_output (MultiloadCollector *c, LoadData *xd)
 {
-	g_snprintf(g->output_str[LOADAVG_1], sizeof(g->output_str[LOADAVG_1]), "%.02f", xd->loadavg[LOADAVG_1]);
-	g_snprintf(g->output_str[LOADAVG_5], sizeof(g->output_str[LOADAVG_5]), "%.02f", xd->loadavg[LOADAVG_5]);
-	g_snprintf(g->output_str[LOADAVG_15], sizeof(g->output_str[LOADAVG_15]), "%.02f", xd->loadavg[LOADAVG_15]);
-	g_snprintf(g->output_str[LOADAVG_PROC], sizeof(g->output_str[LOADAVG_PROC]), "%u/%u", xd->proc_active, xd->proc_count);
+	g_snprintf(c->output_str[LOADAVG_1], sizeof(c->output_str[LOADAVG_1]), "%.02f", xd->loadavg[LOADAVG_1]);
+	g_snprintf(c->output_str[LOADAVG_5], sizeof(c->output_str[LOADAVG_5]), "%.02f", xd->loadavg[LOADAVG_5]);
+	g_snprintf(c->output_str[LOADAVG_15], sizeof(c->output_str[LOADAVG_15]), "%.02f", xd->loadavg[LOADAVG_15]);
+	g_snprintf(c->output_str[LOADAVG_PROC], sizeof(c->output_str[LOADAVG_PROC]), "%u/%u", xd->proc_active, xd->proc_count);
 }
 
 void
-multiload_graph_load_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, LoadData *xd, gint style)
+multiload_graph_load_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, LoadData *xd, gint style)
 {
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 		if (xd->uname[0] != 0)
@@ -28,76 +28,171 @@
 
 #include "graph-data.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 #define PATH_MEMINFO "/proc/meminfo"
 
+/* convert the memory breakdown to graph heights */
+static void
+multiload_graph_mem_fill_data (int Maximum, int data [5], MemoryData *xd)
+{
+	data [0] = rint (Maximum * (float)xd->user / (float)xd->total);
+	data [1] = rint (Maximum * (float)xd->buffers / (float)xd->total);
+	data [2] = rint (Maximum * (float)xd->cache / (float)xd->total);
+	data [3] = rint (Maximum * (float)xd->dirty / (float)xd->total);
+	data [4] = rint (Maximum * (float)xd->hugepages / (float)xd->total);
+}
+
+/* cgroup scope: no buffers here, page cache is charged as "file" */
+static void
+multiload_graph_mem_get_data_cgroup (int Maximum, int data [5], MultiloadCollector *c, MemoryData *xd)
+{
+	MultiloadCgroupMemoryStat stat;
+	guint64 kb_main_total = 0;
+
+	if (!multiload_cgroup_read_memory(c->cgroup, &stat) || !info_file_read_key_uint64 (PATH_MEMINFO, "MemTotal", &kb_main_total)) {
+		memset(data, 0, 5*sizeof(data[0]));
+		xd->user = xd->buffers = xd->cache = xd->dirty = xd->hugepages = 0;
+		return;
+	}
+
+	// graph is relative to the cgroup limit, if there is one
+	xd->total = kb_main_total * 1024;
+	if (stat.max > 0 && stat.max < xd->total)
+		xd->total = stat.max;
+
+	xd->cache = stat.file;
+	if (xd->procps_compliant)
+		xd->cache += stat.slab_reclaimable;
+
+	xd->buffers = 0;
+	xd->hugepages = 0; // charged to hugetlb controller, not to memory.current
+	xd->user = (stat.current > xd->cache) ? stat.current - xd->cache : 0;
+
+	xd->dirty = 0;
+	if (xd->show_dirty) {
+		xd->dirty = MIN(stat.file_dirty + stat.file_writeback, xd->cache);
+		xd->cache -= xd->dirty;
+	}
+
+	xd->available = (xd->total > stat.current) ? xd->total - stat.current : 0;
+	xd->shmem = stat.shmem;
+	xd->slab_reclaimable = stat.slab_reclaimable;
+	xd->anon = stat.anon;
+
+	multiload_graph_mem_fill_data(Maximum, data, xd);
+}
+
 void
-multiload_graph_mem_get_data (int Maximum, int data [4], LoadGraph *g, MemoryData *xd, gboolean first_call)
+multiload_graph_mem_get_data (int Maximum, int data [5], MultiloadCollector *c, MemoryData *xd, gboolean first_call)
 {
-	// displayed keys
-	static guint64 kb_main_total = 0;
-	static guint64 kb_main_buffers = 0;
-	static guint64 kb_main_cached = 0;
-	static guint64 kb_main_used = 0;
-
-	// auxiliary keys
-	static guint64 kb_main_free = 0;
-	static guint64 kb_page_cache = 0;
-	static guint64 kb_slab = 0;
-
-	static const InfoFileMappingEntry table[] = {
-		{ "MemTotal",		'u',	&kb_main_total },
-		{ "MemFree",		'u',	&kb_main_free},
-		{ "Buffers",		'u',	&kb_main_buffers },
-		{ "Cached",			'u',	&kb_page_cache },
-		{ "Slab",			'u',	&kb_slab }
+	// pressure is only shown in tooltip
+	if (c->tooltip_update)
+		multiload_cgroup_read_pressure(c->cgroup, CGROUP_RESOURCE_MEMORY, &xd->pressure);
+
+	if (c->cgroup != NULL) {
+		multiload_graph_mem_get_data_cgroup(Maximum, data, c, xd);
+		return;
+	}
+
+	guint64 kb_main_total = 0;
+	guint64 kb_main_free = 0;
+	guint64 kb_available = 0;
+	guint64 kb_buffers = 0;
+	guint64 kb_cached = 0;
+	guint64 kb_shmem = 0;
+	guint64 kb_sreclaimable = 0;
+	guint64 kb_dirty = 0;
+	guint64 kb_writeback = 0;
+	guint64 kb_anon = 0;
+	guint64 hp_total = 0;
+	guint64 kb_hp_size = 0;
+
+	// all keys are read in a single pass
+	const InfoFileMappingEntry table[] = {
+		{ "MemTotal",			'u',	&kb_main_total },
+		{ "MemFree",			'u',	&kb_main_free },
+		{ "MemAvailable",		'u',	&kb_available },
+		{ "Buffers",			'u',	&kb_buffers },
+		{ "Cached",				'u',	&kb_cached },
+		{ "Shmem",				'u',	&kb_shmem },
+		{ "SReclaimable",		'u',	&kb_sreclaimable },
+		{ "Dirty",				'u',	&kb_dirty },
+		{ "Writeback",			'u',	&kb_writeback },
+		{ "AnonPages",			'u',	&kb_anon },
+		{ "HugePages_Total",	'u',	&hp_total },
+		{ "Hugepagesize",		'u',	&kb_hp_size }
 	};
 
-	gint r = info_file_read_keys (PATH_MEMINFO, table, 5);
-	g_assert_cmpint(r, ==, 5);
+	// MemAvailable (3.14+) and hugepages keys may be missing
+	gint r = info_file_read_keys (PATH_MEMINFO, table, G_N_ELEMENTS(table));
+	g_assert_cmpint(r, >=, 4);
+	g_assert_cmpuint(kb_main_total, >, 0);
+
+	if (kb_available == 0)
+		kb_available = kb_main_free + kb_buffers + kb_cached;
 
-	kb_main_cached = kb_page_cache;
+	guint64 kb_main_cached = kb_cached;
 	if (xd->procps_compliant)
-		kb_main_cached += kb_slab;
+		kb_main_cached += kb_sreclaimable;
 
-	kb_main_used = kb_main_total - kb_main_free - kb_main_cached - kb_main_buffers;
-	if (kb_main_used < 0)
+	guint64 kb_main_used;
+	if (kb_main_free + kb_main_cached + kb_buffers <= kb_main_total)
+		kb_main_used = kb_main_total - kb_main_free - kb_main_cached - kb_buffers;
+	else
 		kb_main_used = kb_main_total - kb_main_free;
 
+	// optional series are carved out of the ones that contain them
+	guint64 kb_main_dirty = 0;
+	if (xd->show_dirty) {
+		kb_main_dirty = MIN(kb_dirty + kb_writeback, kb_main_cached);
+		kb_main_cached -= kb_main_dirty;
+	}
+
+	guint64 kb_main_hugepages = 0;
+	if (xd->show_hugepages) {
+		kb_main_hugepages = MIN(hp_total * kb_hp_size, kb_main_used);
+		kb_main_used -= kb_main_hugepages;
+	}
+
 	xd->user = kb_main_used * 1024;
-	xd->buffers = kb_main_buffers * 1024;
+	xd->buffers = kb_buffers * 1024;
 	xd->cache = kb_main_cached * 1024;
+	xd->dirty = kb_main_dirty * 1024;
+	xd->hugepages = kb_main_hugepages * 1024;
 	xd->total = kb_main_total * 1024;
 
-	data [0] = rint (Maximum * (float)kb_main_used   / (float)kb_main_total);
-	data [1] = rint (Maximum * (float)kb_main_buffers / (float)kb_main_total);
-	data [2] = rint (Maximum * (float)kb_main_cached / (float)kb_main_total);
+	xd->available = kb_available * 1024;
+	xd->shmem = kb_shmem * 1024;
+	xd->slab_reclaimable = kb_sreclaimable * 1024;
+	xd->anon = kb_anon * 1024;
+
+	multiload_graph_mem_fill_data(Maximum, data, xd);
 }
 
 
 void
-multiload_graph_mem_cmdline_output (LoadGraph *g, MemoryData *xd)
+multiload_graph_mem_cmdline_output (MultiloadCollector *c, MemoryData *xd)
 {
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%"G_GUINT64_FORMAT, xd->user);
-	g_snprintf(g->output_str[1], sizeof(g->output_str[1]), "%"G_GUINT64_FORMAT, xd->buffers);
-	g_snprintf(g->output_str[2], sizeof(g->output_str[2]), "%"G_GUINT64_FORMAT, xd->cache);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%"G_GUINT64_FORMAT, xd->user);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%"G_GUINT64_FORMAT, xd->buffers);
+	g_snprintf(c->output_str[2], sizeof(c->output_str[2]), "%"G_GUINT64_FORMAT, xd->cache);
+	g_snprintf(c->output_str[3], sizeof(c->output_str[3]), "%"G_GUINT64_FORMAT, xd->dirty);
 }
 
 void
-multiload_graph_mem_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, MemoryData *xd, gint style)
+multiload_graph_mem_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, MemoryData *xd, gint style)
 {
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
-		gchar *total = format_size_for_display(xd->total, g->multiload->size_format_iec);
+		gchar *total = format_size_for_display(xd->total, c->size_format_iec);
 
-		gchar *user = format_size_for_display(xd->user, g->multiload->size_format_iec);
+		gchar *user = format_size_for_display(xd->user, c->size_format_iec);
 		gchar *user_percent = format_percent(xd->user, xd->total, 1);
 
-		gchar *buffers = format_size_for_display(xd->buffers, g->multiload->size_format_iec);
+		gchar *buffers = format_size_for_display(xd->buffers, c->size_format_iec);
 		gchar *buffers_percent = format_percent(xd->buffers, xd->total, 1);
 
-		gchar *cache = format_size_for_display(xd->cache, g->multiload->size_format_iec);
+		gchar *cache = format_size_for_display(xd->cache, c->size_format_iec);
 		gchar *cache_percent = format_percent(xd->cache, xd->total, 1);
 
 		g_snprintf(buf_title, len_title, _("%s of RAM"), total);
@@ -107,6 +202,29 @@ multiload_graph_mem_tooltip_update (char *buf_title, size_t len_title, char *buf
 											user_percent, user,
 											buffers_percent, buffers,
 											cache_percent, cache);
+
+		if (xd->show_dirty) {
+			gchar *dirty = format_size_for_display(xd->dirty, c->size_format_iec);
+			str_append_printf(buf_text, len_text, _("\n%s waiting to be written back"), dirty);
+			g_free(dirty);
+		}
+		if (xd->show_hugepages && xd->hugepages > 0) {
+			gchar *hugepages = format_size_for_display(xd->hugepages, c->size_format_iec);
+			str_append_printf(buf_text, len_text, _("\n%s reserved for huge pages"), hugepages);
+			g_free(hugepages);
+		}
+
+		gchar *available = format_size_for_display(xd->available, c->size_format_iec);
+		gchar *shmem = format_size_for_display(xd->shmem, c->size_format_iec);
+		str_append_printf(buf_text, len_text, _("\n%s available, %s shared"), available, shmem);
+		g_free(available);
+		g_free(shmem);
+
+		if (c->cgroup != NULL)
+			str_append_printf(buf_text, len_text, _("\nControl group: %s"), c->cgroup->scope);
+		if (xd->pressure.valid)
+			str_append_printf(buf_text, len_text, _("\nPressure: %.1f%% some, %.1f%% full"), xd->pressure.some_avg10, xd->pressure.full_avg10);
+
 		g_free(total);
 		g_free(user);
 		g_free(user_percent);
@@ -22,23 +22,45 @@
 #include <config.h>
 
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <math.h>
 #include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 
 #include "graph-data.h"
 #include "autoscaler.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 
 #define PATH_NET_DEV "/proc/net/dev"
+#define PATH_NET_SNMP "/proc/net/snmp"
+
+enum {
+	NET_IN		= 0,
+	NET_OUT		= 1,
+	NET_LOCAL	= 2,
+
+	NET_MAX		= 3
+};
 
 typedef struct {
 	char name[32];
 	guint64 rx_bytes;
 	guint64 tx_bytes;
 
+	// extended counters, parsed in the same sscanf
+	guint64 rx_packets;
+	guint64 tx_packets;
+	guint64 rx_errs;
+	guint64 tx_errs;
+	guint64 rx_drop;
+	guint64 tx_drop;
+
 	gchar path_address[PATH_MAX];
 	char address[40]; // enough for IPv6 addresses
 
@@ -63,13 +85,253 @@ sort_if_data_by_ifindex (gconstpointer a, gconstpointer b)
 
 
 void
-multiload_graph_net_init (LoadGraph *g, NetData *xd)
+multiload_graph_net_init (MultiloadCollector *c, NetData *xd)
+{
+	xd->snmp_fd = -1;
+	xd->link_fd = -1;
+	xd->link_generation = 1;
+	c->strip_max = MAX_STRIPS;
+}
+
+void
+multiload_graph_net_free (MultiloadCollector *c, NetData *xd)
+{
+	g_free(xd->iface);
+
+	if (xd->snmp_fd >= 0)
+		close(xd->snmp_fd);
+	xd->snmp_fd = -1;
+
+	if (xd->link_fd >= 0)
+		close(xd->link_fd);
+	xd->link_fd = -1;
+}
+
+/* Link speeds are read once, then again only when the kernel reports a link
+ * change (cable plugged, renegotiation, bond slave added...). Notifications
+ * come from a netlink socket, drained without blocking at each sample. If
+ * the socket is not available, speeds are refreshed when interfaces change. */
+static void
+multiload_graph_net_check_link_events (NetData *xd)
+{
+	struct sockaddr_nl addr;
+	gchar buf[4096];
+	gboolean changed = FALSE;
+
+	if (xd->link_fd < 0) {
+		xd->link_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+		if (xd->link_fd < 0) {
+			g_debug("[graph-net] Unable to open netlink socket: %s", g_strerror(errno));
+			return;
+		}
+
+		memset(&addr, 0, sizeof(addr));
+		addr.nl_family = AF_NETLINK;
+		addr.nl_groups = RTMGRP_LINK;
+		if (bind(xd->link_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+			g_debug("[graph-net] Unable to bind netlink socket: %s", g_strerror(errno));
+			close(xd->link_fd);
+			xd->link_fd = -1;
+			return;
+		}
+	}
+
+	// contents do not matter, any message invalidates all speeds
+	while (recv(xd->link_fd, buf, sizeof(buf), MSG_DONTWAIT) > 0)
+		changed = TRUE;
+
+	if (changed) {
+		xd->link_generation++;
+		g_debug("[graph-net] Link change detected, link speeds will be read again");
+	}
+}
+
+/* Returns link speed of interface in Mbit/s (0 if unknown, e.g. wireless or
+ * virtual devices), reading sysfs only when speed is not up to date. */
+static guint64
+multiload_graph_net_get_link_speed (NetData *xd, NetIface *ni)
+{
+	gchar path[PATH_MAX];
+	gint64 speed;
+
+	if (ni->link_generation == xd->link_generation)
+		return ni->link_speed;
+
+	g_snprintf(path, sizeof(path), "/sys/class/net/%s/speed", ni->name);
+	if (!info_file_read_int64(path, &speed) || speed < 0)
+		speed = 0; // reading fails when link is down
+
+	ni->link_speed = speed;
+	ni->link_generation = xd->link_generation;
+	g_debug("[graph-net] Link speed of '%s': %"G_GINT64_FORMAT" Mbit/s", ni->name, speed);
+
+	return ni->link_speed;
+}
+
+/* Maximum bytes transferred in one interval at given link speed (Mbit/s).
+ * Links are full duplex and graphs stack input over output, so the scale is
+ * twice the speed of one direction: a saturated link fills the graph. */
+static gdouble
+multiload_graph_net_link_max (MultiloadCollector *c, guint64 speed)
+{
+	return 2.0 * speed * 1000000 / 8 * c->interval / 1000;
+}
+
+/* Returns state of interface with given ifindex, growing the array if needed.
+ * Indexes are small and dense on most systems, so this stays compact. */
+static NetIface *
+multiload_graph_net_get_iface (NetData *xd, guint ifindex)
+{
+	if (ifindex >= xd->iface_len) {
+		guint len = (ifindex + 16) & ~15u;
+		xd->iface = g_renew(NetIface, xd->iface, len);
+		memset(xd->iface + xd->iface_len, 0, (len - xd->iface_len) * sizeof(NetIface));
+		xd->iface_len = len;
+	}
+	return &xd->iface[ifindex];
+}
+
+/* Fills data of each strip from interfaces listed in strip_ifindex. Strips
+ * are laid out again only when the set of interfaces changes. */
+static void
+multiload_graph_net_update_strips (int Maximum, int data[], MultiloadCollector *c, NetData *xd, guint ifindex[MAX_STRIPS], guint count)
+{
+	AutoScaler *scaler = &xd->scaler;
+	guint i;
+
+	if (count != xd->strip_count || memcmp(ifindex, xd->strip_ifindex, count * sizeof(ifindex[0])) != 0) {
+		memcpy(xd->strip_ifindex, ifindex, count * sizeof(ifindex[0]));
+		xd->strip_count = count;
+		multiload_collector_set_strips(c, count);
+
+		for (i = 0; i < count; i++) {
+			memset(&xd->strip_scaler[i], 0, sizeof(AutoScaler));
+			autoscaler_set_enabled(&xd->strip_scaler[i], autoscaler_get_enabled(scaler));
+			autoscaler_set_min(&xd->strip_scaler[i], scaler->min);
+		}
+		g_debug("[graph-net] Interface set changed, drawing %u strips", count);
+	}
+
+	for (i = 0; i < count; i++) {
+		NetIface *ni = &xd->iface[ifindex[i]];
+		AutoScaler *s = &xd->strip_scaler[i];
+		int *strip_data = data + i * NET_MAX;
+		gdouble max;
+
+		// fixed max applies to each interface
+		if (!autoscaler_get_enabled(s))
+			s->max = scaler->max;
+
+		if (xd->scale_link_speed && ni->link_speed > 0)
+			max = multiload_graph_net_link_max(c, ni->link_speed);
+		else
+			max = autoscaler_get_max(s, c, ni->rx_delta + ni->tx_delta);
+
+		c->scale[i] = max;
+		if (max > 0) {
+			strip_data[NET_IN] = rint (Maximum * (float)ni->rx_delta / max);
+			strip_data[NET_OUT] = rint (Maximum * (float)ni->tx_delta / max);
+		} else {
+			strip_data[NET_IN] = strip_data[NET_OUT] = 0;
+		}
+		strip_data[NET_LOCAL] = 0;
+	}
+}
+
+/* Returns the space separated field at index col of line, or NULL */
+static const gchar*
+multiload_graph_net_field (const gchar *line, gint col)
+{
+	for (; col > 0 && line != NULL; col--) {
+		line = strchr(line, ' ');
+		if (line != NULL)
+			line++;
+	}
+	return line;
+}
+
+/* Index of field name in a line of space separated names, -1 if missing */
+static gint
+multiload_graph_net_column (const gchar *line, const gchar *name)
 {
+	gsize len = strlen(name);
+	gint col;
 
+	for (col = 0; line != NULL; col++) {
+		if (strncmp(line, name, len) == 0 && (line[len] == ' ' || line[len] == '\0'))
+			return col;
+		line = multiload_graph_net_field(line, 1);
+	}
+	return -1;
+}
+
+/* TCP counters are in a pair of "Tcp:" lines, the first one holding field
+ * names. Descriptor is kept open, so this costs a single pread(). Lines are
+ * parsed in place, without allocations. */
+static gboolean
+multiload_graph_net_read_tcp (NetData *xd, guint64 *retrans, guint64 *out_segs)
+{
+	gchar buf[4096];
+	gchar *names = NULL, *values = NULL;
+	gchar *line, *next;
+	const gchar *field;
+	gssize n;
+	gint col;
+	guint found = 0;
+
+	if (xd->snmp_fd < 0) {
+		xd->snmp_fd = info_file_open(PATH_NET_SNMP, O_RDONLY | O_CLOEXEC);
+		if (xd->snmp_fd < 0)
+			return FALSE;
+	}
+
+	n = pread(xd->snmp_fd, buf, sizeof(buf)-1, 0);
+	if (n <= 0) {
+		g_debug("[graph-net] Unable to read '%s': %s", PATH_NET_SNMP, g_strerror(errno));
+		close(xd->snmp_fd);
+		xd->snmp_fd = -1;
+		return FALSE;
+	}
+	buf[n] = '\0';
+
+	for (line = buf; line != NULL && *line != '\0'; line = next) {
+		next = strchr(line, '\n');
+		if (next != NULL)
+			*(next++) = '\0';
+
+		if (strncmp(line, "Tcp: ", 5) != 0)
+			continue;
+
+		if (names == NULL) {
+			names = line+5;
+		} else {
+			values = line+5;
+			break;
+		}
+	}
+
+	if (names == NULL || values == NULL)
+		return FALSE;
+
+	col = multiload_graph_net_column(names, "RetransSegs");
+	field = (col >= 0) ? multiload_graph_net_field(values, col) : NULL;
+	if (field != NULL) {
+		*retrans = g_ascii_strtoull(field, NULL, 10);
+		found++;
+	}
+
+	col = multiload_graph_net_column(names, "OutSegs");
+	field = (col >= 0) ? multiload_graph_net_field(values, col) : NULL;
+	if (field != NULL) {
+		*out_segs = g_ascii_strtoull(field, NULL, 10);
+		found++;
+	}
+
+	return (found == 2);
 }
 
 MultiloadFilter *
-multiload_graph_net_get_filter (LoadGraph *g, NetData *xd)
+multiload_graph_net_get_filter (MultiloadCollector *c, NetData *xd)
 {
 	char *buf = NULL;
 	size_t n = 0;
@@ -94,23 +356,15 @@ multiload_graph_net_get_filter (LoadGraph *g, NetData *xd)
 	g_free(buf);
 	fclose(f);
 
-	multiload_filter_import_existing(filter, g->config->filter);
+	multiload_filter_import_existing(filter, c->filter);
 
 	return filter;
 }
 
 
 void
-multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *xd, gboolean first_call)
+multiload_graph_net_get_data (int Maximum, int data [3], MultiloadCollector *c, NetData *xd, gboolean first_call)
 {
-	enum {
-		NET_IN		= 0,
-		NET_OUT		= 1,
-		NET_LOCAL	= 2,
-
-		NET_MAX		= 3
-	};
-
 	static GHashTable *table = NULL;
 
 	char *buf = NULL;
@@ -123,6 +377,13 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 	gint64 delta[NET_MAX];
 	gint64 total = 0;
 
+	guint64 present_ext[NET_EXT_MAX];
+	memset(present_ext, 0, sizeof(present_ext));
+
+	guint strip_ifindex[MAX_STRIPS];
+	guint strip_count = 0;
+	NetIface *ni;
+
 	if_data d;
 	if_data *d_ptr;
 
@@ -133,6 +394,11 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 	}
 
 	xd->ifaces[0] = 0;
+	xd->sample++;
+	xd->link_capacity = 0;
+
+	if (xd->scale_link_speed)
+		multiload_graph_net_check_link_events(xd);
 
 	f_net = info_file_required_fopen(PATH_NET_DEV, "r");
 	while (getline(&buf, &n, f_net) >= 0) {
@@ -140,7 +406,9 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 		if (strchr(buf, ':') == NULL)
 			continue;
 
-		if (3 != sscanf(buf, "%s %"G_GUINT64_FORMAT" %*u %*u %*u %*u %*u %*u %*u %"G_GUINT64_FORMAT, d.name, &d.rx_bytes, &d.tx_bytes))
+		// receive: bytes packets errs drop fifo frame compressed multicast, transmit: bytes packets errs drop ...
+		if (9 != sscanf(buf, "%s %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %*u %*u %*u %*u %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT,
+							d.name, &d.rx_bytes, &d.rx_packets, &d.rx_errs, &d.rx_drop, &d.tx_bytes, &d.tx_packets, &d.tx_errs, &d.tx_drop))
 			continue; // bad data
 		d.name[strlen(d.name)-1] = '\0'; // remove trailing colon
 
@@ -163,6 +431,12 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 
 		d_ptr->rx_bytes = d.rx_bytes;
 		d_ptr->tx_bytes = d.tx_bytes;
+		d_ptr->rx_packets = d.rx_packets;
+		d_ptr->tx_packets = d.tx_packets;
+		d_ptr->rx_errs = d.rx_errs;
+		d_ptr->tx_errs = d.tx_errs;
+		d_ptr->rx_drop = d.rx_drop;
+		d_ptr->tx_drop = d.tx_drop;
 
 		if (!info_file_read_hex64(d_ptr->path_flags, &d_ptr->flags))
 			continue;
@@ -201,8 +475,8 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 			}
 		}
 
-		if (ignore == FALSE && g->config->filter_enable) {
-			MultiloadFilter *filter = multiload_filter_new_from_existing(g->config->filter);
+		if (ignore == FALSE && c->filter_enable) {
+			MultiloadFilter *filter = multiload_filter_new_from_existing(c->filter);
 			for (j=0, ignore=TRUE; j<multiload_filter_get_length(filter); j++) {
 				if (strcmp(multiload_filter_get_element_data(filter,j), d_ptr->name) == 0) {
 					ignore = FALSE;
@@ -224,7 +498,41 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 		} else {
 			present[NET_IN] += d_ptr->rx_bytes;
 			present[NET_OUT] += d_ptr->tx_bytes;
+			present_ext[NET_EXT_RX_PACKETS] += d_ptr->rx_packets;
+			present_ext[NET_EXT_TX_PACKETS] += d_ptr->tx_packets;
+
+			if (xd->show_per_iface || xd->scale_link_speed) {
+				ni = multiload_graph_net_get_iface(xd, d_ptr->ifindex);
+
+				// ifindex can be reused by a different interface
+				if (strcmp(ni->name, d_ptr->name) != 0) {
+					g_strlcpy(ni->name, d_ptr->name, sizeof(ni->name));
+					ni->sample = 0;
+					ni->link_generation = 0;
+				}
+
+				// speed is known only if interface was there in previous sample too
+				if (ni->sample > 0 && ni->sample == xd->sample - 1 && d_ptr->rx_bytes >= ni->last_rx && d_ptr->tx_bytes >= ni->last_tx) {
+					ni->rx_delta = d_ptr->rx_bytes - ni->last_rx;
+					ni->tx_delta = d_ptr->tx_bytes - ni->last_tx;
+				} else {
+					ni->rx_delta = ni->tx_delta = 0;
+				}
+				ni->last_rx = d_ptr->rx_bytes;
+				ni->last_tx = d_ptr->tx_bytes;
+				ni->sample = xd->sample;
+
+				if (xd->scale_link_speed)
+					xd->link_capacity += multiload_graph_net_get_link_speed(xd, ni);
+
+				if (xd->show_per_iface && strip_count < MAX_STRIPS)
+					strip_ifindex[strip_count++] = d_ptr->ifindex;
+			}
 		}
+		present_ext[NET_EXT_RX_ERRORS] += d_ptr->rx_errs;
+		present_ext[NET_EXT_TX_ERRORS] += d_ptr->tx_errs;
+		present_ext[NET_EXT_RX_DROPS] += d_ptr->rx_drop;
+		present_ext[NET_EXT_TX_DROPS] += d_ptr->tx_drop;
 
 		g_strlcat (xd->ifaces, d_ptr->name, sizeof(xd->ifaces));
 		g_strlcat (xd->ifaces, ", ", sizeof(xd->ifaces));
@@ -233,13 +541,18 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 	g_array_free(valid_ifaces, TRUE);
 	xd->ifaces[strlen(xd->ifaces)-2] = 0;
 
+	// TCP counters are system wide, not affected by interface filter
+	if (xd->show_extended)
+		multiload_graph_net_read_tcp(xd, &present_ext[NET_EXT_TCP_RETRANS], &present_ext[NET_EXT_TCP_OUT]);
+
 
-	if (G_UNLIKELY(first_call || g->filter_changed)) { // avoid initial spike
+	if (G_UNLIKELY(first_call || c->filter_changed)) { // avoid initial spike
 		xd->in_speed = 0;
 		xd->out_speed = 0;
 		xd->local_speed = 0;
+		memset(xd->ext_rate, 0, sizeof(xd->ext_rate));
 
-		g->filter_changed = FALSE;
+		c->filter_changed = FALSE;
 
 		memset(data, 0, NET_MAX * sizeof data[0]);
 	} else {
@@ -253,39 +566,66 @@ multiload_graph_net_get_data (int Maximum, int data [3], LoadGraph *g, NetData *
 			total += delta[i];
 		}
 
-		int max = autoscaler_get_max(&xd->scaler, g, total);
+		gdouble max;
+		if (xd->scale_link_speed && xd->link_capacity > 0) {
+			// loopback traffic does not use the link, it gets its own room on top
+			max = multiload_graph_net_link_max(c, xd->link_capacity);
+			if (autoscaler_get_enabled(&xd->scaler))
+				max += autoscaler_get_max(&xd->scaler, c, delta[NET_LOCAL]);
+		} else
+			max = autoscaler_get_max(&xd->scaler, c, total);
+		c->scale[0] = max;
+
+		xd->in_speed	= calculate_speed(delta[NET_IN], 	c->interval);
+		xd->out_speed	= calculate_speed(delta[NET_OUT],	c->interval);
+		xd->local_speed	= calculate_speed(delta[NET_LOCAL],	c->interval);
 
-		xd->in_speed	= calculate_speed(delta[NET_IN], 	g->config->interval);
-		xd->out_speed	= calculate_speed(delta[NET_OUT],	g->config->interval);
-		xd->local_speed	= calculate_speed(delta[NET_LOCAL],	g->config->interval);
+		// counters can go back when interfaces disappear
+		for (i = 0; i < NET_EXT_MAX; i++)
+			xd->ext_rate[i] = (present_ext[i] >= xd->last_ext[i]) ? calculate_speed(present_ext[i] - xd->last_ext[i], c->interval) : 0;
+
+		// TCP counters were not read last time (extended mode just enabled)
+		if (xd->last_ext[NET_EXT_TCP_OUT] == 0)
+			xd->ext_rate[NET_EXT_TCP_RETRANS] = xd->ext_rate[NET_EXT_TCP_OUT] = 0;
 
 		if (max == 0) {
-			memset(data, 0, 4*sizeof(data[0]));
+			memset(data, 0, NET_MAX*sizeof(data[0]));
 		} else {
 			for (i=0; i<NET_MAX; i++)
 				data[i] = rint (Maximum * (float)delta[i] / max);
 		}
 	}
 
+	// with a single interface (or none) there is nothing to split
+	if (strip_count > 1) {
+		multiload_graph_net_update_strips(Maximum, data, c, xd, strip_ifindex, strip_count);
+	} else if (xd->strip_count > 0) {
+		xd->strip_count = 0;
+		multiload_collector_set_strips(c, 1);
+	}
+
 	memcpy(xd->last, present, sizeof xd->last);
+	memcpy(xd->last_ext, present_ext, sizeof xd->last_ext);
 }
 
 
 void
-multiload_graph_net_cmdline_output (LoadGraph *g, NetData *xd)
+multiload_graph_net_cmdline_output (MultiloadCollector *c, NetData *xd)
 {
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%"G_GUINT64_FORMAT, xd->in_speed);
-	g_snprintf(g->output_str[1], sizeof(g->output_str[1]), "%"G_GUINT64_FORMAT, xd->out_speed);
-	g_snprintf(g->output_str[2], sizeof(g->output_str[2]), "%"G_GUINT64_FORMAT, xd->local_speed);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%"G_GUINT64_FORMAT, xd->in_speed);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%"G_GUINT64_FORMAT, xd->out_speed);
+	g_snprintf(c->output_str[2], sizeof(c->output_str[2]), "%"G_GUINT64_FORMAT, xd->local_speed);
 }
 
 
 void
-multiload_graph_net_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, NetData *xd, gint style)
+multiload_graph_net_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, NetData *xd, gint style)
 {
-	gchar *tx_in = format_rate_for_display(xd->in_speed, g->multiload->size_format_iec);
-	gchar *tx_out = format_rate_for_display(xd->out_speed, g->multiload->size_format_iec);
-	gchar *tx_local = format_rate_for_display(xd->local_speed, g->multiload->size_format_iec);
+	gchar *tx_in = format_rate_for_display(xd->in_speed, c->size_format_iec);
+	gchar *tx_out = format_rate_for_display(xd->out_speed, c->size_format_iec);
+	gchar *tx_local = format_rate_for_display(xd->local_speed, c->size_format_iec);
+	guint64 link_bytes = xd->link_capacity * 1000000 / 8; // per second
+	guint i;
 
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 		g_snprintf(buf_text, len_text, _(	"Monitored interfaces: %s\n"
@@ -294,8 +634,59 @@ multiload_graph_net_tooltip_update (char *buf_title, size_t len_title, char *buf
 											"Sending: %s\n"
 											"Local: %s"),
 											xd->ifaces, tx_in, tx_out, tx_local);
+
+		// same definition as graph scale: both directions, loopback excluded
+		if (xd->scale_link_speed && xd->link_capacity > 0) {
+			gchar *sat = format_percent(xd->in_speed + xd->out_speed, 2 * link_bytes, 0);
+			gchar *sat_in = format_percent(xd->in_speed, link_bytes, 0);
+			gchar *sat_out = format_percent(xd->out_speed, link_bytes, 0);
+			str_append_printf(buf_text, len_text, _("\nLink speed: %lu Mbit/s full duplex (saturation: %s, %s receiving, %s sending)"),
+														(gulong)xd->link_capacity, sat, sat_in, sat_out);
+			g_free(sat);
+			g_free(sat_in);
+			g_free(sat_out);
+		}
+
+		for (i = 0; i < xd->strip_count; i++) {
+			NetIface *ni = &xd->iface[xd->strip_ifindex[i]];
+			guint64 rx_speed = calculate_speed(ni->rx_delta, c->interval);
+			guint64 tx_speed = calculate_speed(ni->tx_delta, c->interval);
+			gchar *rx = format_rate_for_display(rx_speed, c->size_format_iec);
+			gchar *tx = format_rate_for_display(tx_speed, c->size_format_iec);
+			str_append_printf(buf_text, len_text, "%s%s: \xe2\xac\x87%s \xe2\xac\x86%s", (i == 0) ? "\n\n" : "\n", ni->name, rx, tx);
+			g_free(rx);
+			g_free(tx);
+
+			if (xd->scale_link_speed && ni->link_speed > 0) {
+				gchar *sat = format_percent(rx_speed + tx_speed, 2 * ni->link_speed * 1000000 / 8, 0);
+				str_append_printf(buf_text, len_text, " (%s)", sat);
+				g_free(sat);
+			}
+		}
+
+		if (xd->show_extended) {
+			guint64 *r = xd->ext_rate;
+			str_append_printf(buf_text, len_text, _(	"\n\n"
+														"Packets: %lu/s received, %lu/s sent\n"
+														"Errors: %lu/s received, %lu/s sent\n"
+														"Drops: %lu/s received, %lu/s sent"),
+														(gulong)r[NET_EXT_RX_PACKETS], (gulong)r[NET_EXT_TX_PACKETS],
+														(gulong)r[NET_EXT_RX_ERRORS], (gulong)r[NET_EXT_TX_ERRORS],
+														(gulong)r[NET_EXT_RX_DROPS], (gulong)r[NET_EXT_TX_DROPS]);
+			if (r[NET_EXT_TCP_OUT] > 0)
+				str_append_printf(buf_text, len_text, _("\nTCP retransmits: %lu/s (%.2f%% of sent segments)"),
+														(gulong)r[NET_EXT_TCP_RETRANS], 100.0 * r[NET_EXT_TCP_RETRANS] / r[NET_EXT_TCP_OUT]);
+			else
+				str_append_printf(buf_text, len_text, _("\nTCP retransmits: %lu/s"), (gulong)r[NET_EXT_TCP_RETRANS]);
+		}
 	} else {
 		g_snprintf(buf_text, len_text, "\xe2\xac\x87%s \xe2\xac\x86%s", tx_in, tx_out);
+
+		if (xd->scale_link_speed && xd->link_capacity > 0) {
+			gchar *sat = format_percent(xd->in_speed + xd->out_speed, 2 * link_bytes, 0);
+			str_append_printf(buf_text, len_text, " (%s)", sat);
+			g_free(sat);
+		}
 	}
 
 	g_free(tx_in);
@@ -26,12 +26,11 @@
 
 #include "graph-data.h"
 #include "autoscaler.h"
-#include "preferences.h"
 #include "util.h"
 
 
 void
-multiload_graph_parm_get_data (int Maximum, int data[4], LoadGraph *g, ParametricData *xd, gboolean first_call)
+multiload_graph_parm_get_data (int Maximum, int data[4], MultiloadCollector *c, ParametricData *xd, gboolean first_call)
 {
 	int max;
 	gboolean spawn_success;
@@ -99,10 +98,10 @@ multiload_graph_parm_get_data (int Maximum, int data[4], LoadGraph *g, Parametri
 		}
 	}
 
-	if (g == NULL || data == NULL || Maximum == 0)
+	if (c == NULL || data == NULL || Maximum == 0)
 		return; // allow this function to be used just to test command lines
 
-	max = autoscaler_get_max(&xd->scaler, g, rint(total));
+	max = autoscaler_get_max(&xd->scaler, c, rint(total));
 	if (max == 0) {
 		memset(data, 0, 4*sizeof(data[0]));
 	} else {
@@ -113,16 +112,16 @@ multiload_graph_parm_get_data (int Maximum, int data[4], LoadGraph *g, Parametri
 
 
 void
-multiload_graph_parm_cmdline_output (LoadGraph *g, ParametricData *xd)
+multiload_graph_parm_cmdline_output (MultiloadCollector *c, ParametricData *xd)
 {
 	guint i;
 	for (i=0; i<4; i++)
-		g_snprintf(g->output_str[i], sizeof(g->output_str[i]), "%lf", xd->result[i]);
+		g_snprintf(c->output_str[i], sizeof(c->output_str[i]), "%lf", xd->result[i]);
 }
 
 
 void
-multiload_graph_parm_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, ParametricData *xd, gint style)
+multiload_graph_parm_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, ParametricData *xd, gint style)
 {
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 		if (xd->error)
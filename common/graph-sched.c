@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include <config.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "graph-data.h"
+#include "info-file.h"
+#include "proc-stat.h"
+#include "util.h"
+
+#define PATH_SOFTIRQS "/proc/softirqs"
+
+static const gchar *softirq_names[SCHED_SOFTIRQ_MAX] = {
+	"HI", "TIMER", "NET_TX", "NET_RX", "BLOCK", "IRQ_POLL", "TASKLET", "SCHED", "HRTIMER", "RCU"
+};
+
+
+static guint64
+multiload_graph_sched_rate (guint64 diff, gint64 elapsed)
+{
+	if (elapsed <= 0)
+		return 0;
+	return diff * G_USEC_PER_SEC / elapsed;
+}
+
+/* Each row of /proc/softirqs has one counter per CPU, they are summed up */
+static gboolean
+multiload_graph_sched_read_softirqs (guint64 counters[SCHED_SOFTIRQ_MAX])
+{
+	gchar *buf, *line, *next, *pch, *endptr;
+	guint i;
+
+	if (!info_file_read_string(PATH_SOFTIRQS, &buf, NULL))
+		return FALSE;
+
+	memset(counters, 0, SCHED_SOFTIRQ_MAX*sizeof(counters[0]));
+
+	for (line = buf; line != NULL && *line != '\0'; line = next) {
+		next = strchr(line, '\n');
+		if (next != NULL)
+			*(next++) = '\0';
+
+		while (*line == ' ')
+			line++;
+		pch = strchr(line, ':');
+		if (pch == NULL) // header
+			continue;
+		*(pch++) = '\0';
+
+		for (i=0; i<SCHED_SOFTIRQ_MAX; i++) {
+			if (strcmp(line, softirq_names[i]) == 0)
+				break;
+		}
+		if (i == SCHED_SOFTIRQ_MAX)
+			continue;
+
+		for (;;) {
+			guint64 v = g_ascii_strtoull(pch, &endptr, 10);
+			if (endptr == pch)
+				break;
+			counters[i] += v;
+			pch = endptr;
+		}
+	}
+
+	g_free(buf);
+	return TRUE;
+}
+
+void
+multiload_graph_sched_get_data (int Maximum, int data [2], MultiloadCollector *c, SchedData *xd, gboolean first_call)
+{
+	MultiloadProcStat stat;
+	guint64 softirqs[SCHED_SOFTIRQ_MAX];
+	gint64 elapsed;
+	guint i;
+	int max;
+
+	memset(data, 0, 2*sizeof(data[0]));
+
+	/* Processor graph reads /proc/stat too: if it did recently (within half
+	 * of our interval) use its data. Rates are computed over the actual time
+	 * between samples, so a shifted sample does not skew them. */
+	if (!multiload_proc_stat_read(&stat, c->interval * 500))
+		return;
+
+	elapsed = stat.time - xd->last_time;
+	if (G_UNLIKELY(first_call)) // cannot calculate diff on first call
+		elapsed = 0;
+
+	xd->ctxt_rate = multiload_graph_sched_rate(stat.ctxt - xd->last_ctxt, elapsed);
+	xd->intr_rate = multiload_graph_sched_rate(stat.intr - xd->last_intr, elapsed);
+	xd->softirq_rate = multiload_graph_sched_rate(stat.softirq - xd->last_softirq, elapsed);
+	xd->procs_running = stat.procs_running;
+	xd->procs_blocked = stat.procs_blocked;
+
+	if (xd->show_softirqs && multiload_graph_sched_read_softirqs(softirqs)) {
+		// breakdown may have just been enabled
+		gint64 elapsed_class = (xd->last_softirq_class_time > 0) ? stat.time - xd->last_softirq_class_time : 0;
+		for (i=0; i<SCHED_SOFTIRQ_MAX; i++) {
+			xd->softirq_class_rate[i] = multiload_graph_sched_rate(softirqs[i] - xd->last_softirq_class[i], elapsed_class);
+			xd->last_softirq_class[i] = softirqs[i];
+		}
+		xd->last_softirq_class_time = stat.time;
+	} else {
+		xd->last_softirq_class_time = 0;
+	}
+
+	xd->last_ctxt = stat.ctxt;
+	xd->last_intr = stat.intr;
+	xd->last_softirq = stat.softirq;
+	xd->last_time = stat.time;
+
+	max = autoscaler_get_max(&xd->scaler, c, xd->ctxt_rate + xd->intr_rate);
+	if (max > 0) {
+		data [0] = rint (Maximum * (float)xd->ctxt_rate / max);
+		data [1] = rint (Maximum * (float)xd->intr_rate / max);
+	}
+}
+
+
+void
+multiload_graph_sched_cmdline_output (MultiloadCollector *c, SchedData *xd)
+{
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%"G_GUINT64_FORMAT, xd->ctxt_rate);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%"G_GUINT64_FORMAT, xd->intr_rate);
+	g_snprintf(c->output_str[2], sizeof(c->output_str[2]), "%"G_GUINT64_FORMAT, xd->softirq_rate);
+	g_snprintf(c->output_str[3], sizeof(c->output_str[3]), "%u/%u", xd->procs_running, xd->procs_blocked);
+}
+
+
+void
+multiload_graph_sched_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, SchedData *xd, gint style)
+{
+	guint i;
+
+	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
+		g_snprintf(buf_text, len_text, _(	"Context switches: %lu/s\n"
+											"Interrupts: %lu/s\n"
+											"Softirqs: %lu/s\n"
+											"Processes: %u running, %u blocked"),
+											(gulong)xd->ctxt_rate, (gulong)xd->intr_rate, (gulong)xd->softirq_rate,
+											xd->procs_running, xd->procs_blocked);
+
+		if (xd->show_softirqs) {
+			str_append_printf(buf_text, len_text, "\n");
+			for (i=0; i<SCHED_SOFTIRQ_MAX; i++)
+				str_append_printf(buf_text, len_text, "\n%s: %lu/s", softirq_names[i], (gulong)xd->softirq_class_rate[i]);
+		}
+	} else {
+		g_snprintf(buf_text, len_text, _("%lu switches/s, %lu interrupts/s"), (gulong)xd->ctxt_rate, (gulong)xd->intr_rate);
+	}
+}
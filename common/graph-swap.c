@@ -21,64 +21,174 @@
 
 #include <config.h>
 
-#include <ctype.h>
+#include <dirent.h>
 #include <errno.h>
 #include <math.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #include "graph-data.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 #define PATH_MEMINFO "/proc/meminfo"
+#define PATH_VMSTAT "/proc/vmstat"
+#define PATH_BLOCK "/sys/block"
+#define PATH_ZSWAP "/sys/kernel/debug/zswap"
 
 void
-multiload_graph_swap_get_data (int Maximum, int data [1], LoadGraph *g, SwapData *xd, gboolean first_call)
+multiload_graph_swap_init (MultiloadCollector *c, SwapData *xd)
 {
-	// displayed keys
-	static guint64 kb_swap_total = 0;
-	static guint64 kb_swap_free = 0;
+	xd->page_size = sysconf(_SC_PAGESIZE);
+	if (xd->page_size <= 0)
+		xd->page_size = 4096;
+}
+
+/* zram devices: first two fields of mm_stat are original and compressed data size */
+static void
+multiload_graph_swap_read_compressed (SwapData *xd)
+{
+	gchar path[PATH_MAX];
+	gchar buf[256];
+	guint64 orig, compr;
+	struct dirent *e;
+
+	xd->compressed_orig = 0;
+	xd->compressed_size = 0;
+
+	DIR *dir = info_file_opendir(PATH_BLOCK);
+	if (dir != NULL) {
+		while ((e = readdir(dir)) != NULL) {
+			if (strncmp(e->d_name, "zram", 4) != 0)
+				continue;
+
+			g_snprintf(path, sizeof(path), "%s/%s/mm_stat", PATH_BLOCK, e->d_name);
+			if (!info_file_read_string_s(path, buf, sizeof(buf), NULL))
+				continue;
+
+			if (sscanf(buf, "%"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT, &orig, &compr) == 2) {
+				xd->compressed_orig += orig;
+				xd->compressed_size += compr;
+			}
+		}
+		closedir(dir);
+	}
+
+	// zswap statistics live in debugfs, usually readable only by root
+	guint64 stored_pages, pool_size;
+	if (info_file_read_uint64(PATH_ZSWAP "/stored_pages", &stored_pages) && info_file_read_uint64(PATH_ZSWAP "/pool_total_size", &pool_size)) {
+		xd->compressed_orig += stored_pages * xd->page_size;
+		xd->compressed_size += pool_size;
+	}
 
-	static const InfoFileMappingEntry table[] = {
+	if (xd->compressed_size > 0)
+		xd->compression_ratio = (gdouble)xd->compressed_orig / (gdouble)xd->compressed_size;
+	else
+		xd->compression_ratio = 0;
+}
+
+void
+multiload_graph_swap_get_data (int Maximum, int data [3], MultiloadCollector *c, SwapData *xd, gboolean first_call)
+{
+	guint64 kb_swap_total = 0;
+	guint64 kb_swap_free = 0;
+	guint64 pswpin = 0;
+	guint64 pswpout = 0;
+	guint64 indiff, outdiff;
+	int max;
+
+	const InfoFileMappingEntry table_meminfo[] = {
 		{ "SwapTotal",	'u',	&kb_swap_total },
 		{ "SwapFree",	'u',	&kb_swap_free }
 	};
 
-	gint r = info_file_read_keys (PATH_MEMINFO, table, 2);
+	const InfoFileMappingEntry table_vmstat[] = {
+		{ "pswpin",		'u',	&pswpin },
+		{ "pswpout",	'u',	&pswpout }
+	};
+
+	gint r = info_file_read_keys (PATH_MEMINFO, table_meminfo, 2);
 	g_assert_cmpint(r, ==, 2);
 
+	/* Counters are in pages, only needed by activity series and tooltip. When
+	 * they are not read, last values are reset so that no diff is computed
+	 * against stale ones. */
+	if (xd->show_activity || c->tooltip_update)
+		info_file_read_keys (PATH_VMSTAT, table_vmstat, 2);
+
+	if (c->tooltip_update)
+		multiload_graph_swap_read_compressed(xd);
+
 	xd->used = (kb_swap_total - kb_swap_free) * 1024;
 	xd->total = kb_swap_total * 1024;
 
-	if (kb_swap_total == 0)
-	   data [0] = 0;
-	else
-	   data [0] = rint (Maximum * (float)(kb_swap_total - kb_swap_free) / kb_swap_total);
+	indiff = pswpin - xd->last_in;
+	outdiff = pswpout - xd->last_out;
+
+	// cannot calculate diff on first call, or after counters were skipped
+	if (G_UNLIKELY(first_call) || (xd->last_in == 0 && xd->last_out == 0))
+		indiff = outdiff = 0;
+
+	xd->last_in = pswpin;
+	xd->last_out = pswpout;
+
+	xd->in_speed = calculate_speed(indiff * xd->page_size, c->interval);
+	xd->out_speed = calculate_speed(outdiff * xd->page_size, c->interval);
+
+	memset(data, 0, 3*sizeof(data[0]));
+
+	if (xd->show_activity) {
+		max = autoscaler_get_max(&xd->scaler, c, indiff + outdiff);
+		if (max > 0) {
+			data [1] = rint (Maximum * (float)indiff / max);
+			data [2] = rint (Maximum * (float)outdiff / max);
+		}
+	} else if (kb_swap_total > 0) {
+		data [0] = rint (Maximum * (float)(kb_swap_total - kb_swap_free) / kb_swap_total);
+	}
 }
 
 
 void
-multiload_graph_swap_cmdline_output (LoadGraph *g, SwapData *xd)
+multiload_graph_swap_cmdline_output (MultiloadCollector *c, SwapData *xd)
 {
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%"G_GUINT64_FORMAT, xd->used);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%"G_GUINT64_FORMAT, xd->used);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%"G_GUINT64_FORMAT, xd->in_speed);
+	g_snprintf(c->output_str[2], sizeof(c->output_str[2]), "%"G_GUINT64_FORMAT, xd->out_speed);
 }
 
 
 void
-multiload_graph_swap_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, SwapData *xd, gint style)
+multiload_graph_swap_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, SwapData *xd, gint style)
 {
 	if (xd->total == 0) {
 		g_snprintf(buf_text, len_text, _("No swap"));
 	} else {
-		gchar *used = format_size_for_display(xd->used, g->multiload->size_format_iec);
+		gchar *used = format_size_for_display(xd->used, c->size_format_iec);
 		gchar *used_percent = format_percent(xd->used, xd->total, 0);
 
-		gchar *total = format_size_for_display(xd->total, g->multiload->size_format_iec);
+		gchar *total = format_size_for_display(xd->total, c->size_format_iec);
+
+		gchar *swap_in = format_rate_for_display(xd->in_speed, c->size_format_iec);
+		gchar *swap_out = format_rate_for_display(xd->out_speed, c->size_format_iec);
 
 		if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 			g_snprintf(buf_title, len_title, _("%s of swap"), total);
-			g_snprintf(buf_text, len_text, _("%s (%s) used"), used_percent, used);
+			g_snprintf(buf_text, len_text, _(	"%s (%s) used\n"
+												"\n"
+												"Swap in: %s\n"
+												"Swap out: %s"),
+												used_percent, used, swap_in, swap_out);
+
+			if (xd->compression_ratio > 0) {
+				gchar *orig = format_size_for_display(xd->compressed_orig, c->size_format_iec);
+				gchar *compr = format_size_for_display(xd->compressed_size, c->size_format_iec);
+				str_append_printf(buf_text, len_text, _("\nCompressed: %s stored in %s (ratio %.2f)"), orig, compr, xd->compression_ratio);
+				g_free(orig);
+				g_free(compr);
+			}
+		} else if (xd->show_activity) {
+			g_snprintf(buf_text, len_text, "\xe2\xac\x87%s \xe2\xac\x86%s", swap_in, swap_out);
 		} else {
 			g_snprintf(buf_text, len_text, "%s", used_percent);
 		}
@@ -86,5 +196,7 @@ multiload_graph_swap_tooltip_update (char *buf_title, size_t len_title, char *bu
 		g_free(used);
 		g_free(used_percent);
 		g_free(total);
+		g_free(swap_in);
+		g_free(swap_out);
 	}
 }
@@ -29,7 +29,6 @@
 #include "graph-data.h"
 #include "autoscaler.h"
 #include "info-file.h"
-#include "preferences.h"
 #include "util.h"
 
 
@@ -75,7 +74,7 @@ list_temp_acpitz(TemperatureSourceData **list, gboolean init)
 
 	if (init) {
 		// check if /sys node exists, otherwise means no acpitz support
-		dir = opendir(root_node);
+		dir = info_file_opendir(root_node);
 		if (dir == NULL)
 			return FALSE;
 
@@ -107,7 +106,7 @@ list_temp_acpitz(TemperatureSourceData **list, gboolean init)
 
 			// fill name from device path if present, else generate unique name
 			g_snprintf(buf, PATH_MAX, "%s/device/path", li->node_path);
-			if ((f = fopen(buf, "r")) != NULL) {
+			if ((f = info_file_fopen(buf, "r")) != NULL) {
 				s = fscanf(f, "%s", buf);
 				fclose(f);
 
@@ -174,7 +173,7 @@ list_temp_hwmon(TemperatureSourceData **list, gboolean init)
 
 	if (init) {
 		// check if /sys node exists, otherwise means no hwmon support
-		dir = opendir(root_node);
+		dir = info_file_opendir(root_node);
 		if (dir == NULL)
 			return FALSE;
 
@@ -185,7 +184,7 @@ list_temp_hwmon(TemperatureSourceData **list, gboolean init)
 
 			g_snprintf(buf, PATH_MAX, "%s/%s", root_node, dirent->d_name);
 
-			subdir = opendir(buf);
+			subdir = info_file_opendir(buf);
 			if (subdir == NULL)
 				continue;
 
@@ -213,7 +212,7 @@ list_temp_hwmon(TemperatureSourceData **list, gboolean init)
 				continue;
 			g_snprintf(buf, PATH_MAX, "%s/%s", root_node, dirent->d_name);
 
-			subdir = opendir(buf);
+			subdir = info_file_opendir(buf);
 			if (subdir == NULL)
 				continue;
 
@@ -227,7 +226,7 @@ list_temp_hwmon(TemperatureSourceData **list, gboolean init)
 
 				// get hwmon driver name
 				g_snprintf(buf, PATH_MAX, "%s/%s/name", root_node, dirent->d_name);
-				f  = fopen(buf, "r");
+				f  = info_file_fopen(buf, "r");
 				if (f != NULL) {
 					s = fscanf(f, "%s", name);
 					fclose(f);
@@ -237,7 +236,7 @@ list_temp_hwmon(TemperatureSourceData **list, gboolean init)
 				tmp = str_replace(subdirent->d_name, "_input", "_label");
 				g_snprintf(buf, PATH_MAX, "%s/%s/%s", root_node, dirent->d_name, tmp);
 				g_free(tmp);
-				f  = fopen(buf, "r");
+				f  = info_file_fopen(buf, "r");
 				if (f != NULL) {
 					// build format string to accept spaces too
 					tmp = g_strdup_printf("%%%zu[0-9a-zA-Z ]", sizeof(li->name)-1);
@@ -295,13 +294,13 @@ list_temp(TemperatureSourceData **list)
 }
 
 void
-multiload_graph_temp_init (LoadGraph *g, TemperatureData *xd)
+multiload_graph_temp_init (MultiloadCollector *c, TemperatureData *xd)
 {
 	sources_support = list_temp(&sources_list);
 }
 
 MultiloadFilter *
-multiload_graph_temp_get_filter (LoadGraph *g, TemperatureData *xd)
+multiload_graph_temp_get_filter (MultiloadCollector *c, TemperatureData *xd)
 {
 	TemperatureSourceData *list = NULL;
 	guint i;
@@ -312,7 +311,7 @@ multiload_graph_temp_get_filter (LoadGraph *g, TemperatureData *xd)
 		for (i=0; list[i].temp_path[0]!='\0'; i++)
 			multiload_filter_append(filter, list[i].name);
 
-		multiload_filter_import_existing(filter, g->config->filter);
+		multiload_filter_import_existing(filter, c->filter);
 	}
 	g_free(list);
 
@@ -320,7 +319,7 @@ multiload_graph_temp_get_filter (LoadGraph *g, TemperatureData *xd)
 }
 
 void
-multiload_graph_temp_get_data (int Maximum, int data[2], LoadGraph *g, TemperatureData *xd, gboolean first_call)
+multiload_graph_temp_get_data (int Maximum, int data[2], MultiloadCollector *c, TemperatureData *xd, gboolean first_call)
 {
 	TemperatureSourceData *use = NULL;
 
@@ -342,14 +341,14 @@ multiload_graph_temp_get_data (int Maximum, int data[2], LoadGraph *g, Temperatu
 	}
 
 	// select phase: choose which source to show
-	if (g->config->filter_enable && g->config->filter[0] != '\0') {
+	if (c->filter_enable && c->filter[0] != '\0') {
 		for (i=0; sources_list[i].temp_path[0]!='\0'; i++) {
-			if (strcmp(sources_list[i].name, g->config->filter) == 0) {
+			if (strcmp(sources_list[i].name, c->filter) == 0) {
 				use = &sources_list[i];
 				g_debug("[graph-temp] Using source '%s' (selected by filter)", sources_list[i].name);
 				break;
 			}
-			g_debug("[graph-temp] No source found for filter '%s'", g->config->filter);
+			g_debug("[graph-temp] No source found for filter '%s'", c->filter);
 		}
 	}
 	if (use == NULL) { // filter disabled or filter value not found - auto selection
@@ -361,7 +360,7 @@ multiload_graph_temp_get_data (int Maximum, int data[2], LoadGraph *g, Temperatu
 	}
 
 	// output phase
-	int max = autoscaler_get_max(&xd->scaler, g, use->temp);
+	int max = autoscaler_get_max(&xd->scaler, c, use->temp);
 	if (max == 0) {
 		memset(data, 0, 2*sizeof(data[0]));
 	} else {
@@ -381,15 +380,15 @@ multiload_graph_temp_get_data (int Maximum, int data[2], LoadGraph *g, Temperatu
 
 
 void
-multiload_graph_temp_cmdline_output (LoadGraph *g, TemperatureData *xd)
+multiload_graph_temp_cmdline_output (MultiloadCollector *c, TemperatureData *xd)
 {
-	g_snprintf(g->output_str[0], sizeof(g->output_str[0]), "%.03f", xd->value);
-	g_snprintf(g->output_str[1], sizeof(g->output_str[1]), "%.03f", xd->max);
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%.03f", xd->value);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%.03f", xd->max);
 }
 
 
 void
-multiload_graph_temp_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, TemperatureData *xd, gint style)
+multiload_graph_temp_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, TemperatureData *xd, gint style)
 {
 	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
 		strncpy(buf_title, xd->name, len_title);
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "graph-data.h"
+#include "info-file.h"
+#include "util.h"
+
+#define PATH_VMSTAT "/proc/vmstat"
+
+// /proc/vmstat is about 6 KiB on recent kernels
+#define VMSTAT_BUFSIZE 16384
+
+
+void
+multiload_graph_vm_init (MultiloadCollector *c, VmData *xd)
+{
+	xd->fd = -1;
+}
+
+void
+multiload_graph_vm_free (MultiloadCollector *c, VmData *xd)
+{
+	if (xd->fd >= 0)
+		close(xd->fd);
+	xd->fd = -1;
+}
+
+/* Accumulates "<prefix>_<who>[_<zone>]" counters (pgscan_*, pgsteal_*) into
+ * the kswapd or direct bucket. Per-type totals (_anon, _file) are skipped,
+ * they would count the same pages twice. */
+static void
+multiload_graph_vm_add_reclaim (const gchar *who, guint64 value, guint64 *kswapd, guint64 *direct)
+{
+	if (strncmp(who, "direct", 6) == 0) {
+		if (strncmp(who+6, "_throttle", 9) != 0) // this counts events, not pages
+			*direct += value;
+	} else if (strncmp(who, "kswapd", 6) == 0 || strncmp(who, "khugepaged", 10) == 0) {
+		*kswapd += value;
+	}
+}
+
+/* Fast lookup: /proc/vmstat has a couple hundred keys, but only a few starting
+ * with 'p', 'a' and 'c' are interesting. Other lines are skipped after looking
+ * at their first character. */
+static gboolean
+multiload_graph_vm_read (VmData *xd, guint64 counters[VM_COUNTER_MAX])
+{
+	gchar buf[VMSTAT_BUFSIZE];
+	gchar *line, *sep, *next;
+	guint64 value;
+	gssize n;
+
+	if (xd->fd < 0) {
+		xd->fd = info_file_open(PATH_VMSTAT, O_RDONLY | O_CLOEXEC);
+		if (xd->fd < 0)
+			return FALSE;
+	}
+
+	// procfs regenerates contents on each read at offset 0
+	n = pread(xd->fd, buf, sizeof(buf)-1, 0);
+	if (n <= 0) {
+		g_debug("[graph-vm] Unable to read '%s': %s", PATH_VMSTAT, g_strerror(errno));
+		close(xd->fd);
+		xd->fd = -1;
+		return FALSE;
+	}
+	buf[n] = '\0';
+
+	memset(counters, 0, VM_COUNTER_MAX*sizeof(counters[0]));
+
+	for (line = buf; *line != '\0'; line = next) {
+		next = strchr(line, '\n');
+		if (next == NULL)
+			break;
+		next++;
+
+		if (line[0] != 'p' && line[0] != 'a' && line[0] != 'c')
+			continue;
+
+		sep = strchr(line, ' ');
+		if (sep == NULL || sep > next)
+			continue;
+		value = g_ascii_strtoull(sep+1, NULL, 10);
+
+		switch (line[0]) {
+			case 'p':
+				if (line[1] != 'g')
+					break;
+				if (strncmp(line, "pgfault ", 8) == 0)
+					counters[VM_PGFAULT] = value;
+				else if (strncmp(line, "pgmajfault ", 11) == 0)
+					counters[VM_PGMAJFAULT] = value;
+				else if (strncmp(line, "pgscan_", 7) == 0)
+					multiload_graph_vm_add_reclaim(line+7, value, &counters[VM_PGSCAN_KSWAPD], &counters[VM_PGSCAN_DIRECT]);
+				else if (strncmp(line, "pgsteal_", 8) == 0)
+					multiload_graph_vm_add_reclaim(line+8, value, &counters[VM_PGSTEAL_KSWAPD], &counters[VM_PGSTEAL_DIRECT]);
+				break;
+
+			case 'a':
+				// "allocstall" on older kernels, one "allocstall_<zone>" per zone since 4.10
+				if (strncmp(line, "allocstall", 10) == 0)
+					counters[VM_ALLOCSTALL] += value;
+				break;
+
+			case 'c':
+				if (strncmp(line, "compact_stall ", 14) == 0)
+					counters[VM_COMPACT_STALL] = value;
+				break;
+		}
+	}
+
+	return TRUE;
+}
+
+void
+multiload_graph_vm_get_data (int Maximum, int data [2], MultiloadCollector *c, VmData *xd, gboolean first_call)
+{
+	guint64 counters[VM_COUNTER_MAX];
+	guint64 diff[VM_COUNTER_MAX];
+	guint i;
+	int max;
+
+	memset(data, 0, 2*sizeof(data[0]));
+
+	if (!multiload_graph_vm_read(xd, counters))
+		return;
+
+	for (i=0; i<VM_COUNTER_MAX; i++) {
+		diff[i] = counters[i] - xd->last[i];
+		xd->last[i] = counters[i];
+
+		if (G_UNLIKELY(first_call)) // cannot calculate diff on first call
+			diff[i] = 0;
+
+		xd->rate[i] = calculate_speed(diff[i], c->interval);
+	}
+
+	max = autoscaler_get_max(&xd->scaler, c, xd->rate[VM_PGMAJFAULT] + xd->rate[VM_PGSCAN_DIRECT]);
+	if (max > 0) {
+		data [0] = rint (Maximum * (float)xd->rate[VM_PGMAJFAULT] / max);
+		data [1] = rint (Maximum * (float)xd->rate[VM_PGSCAN_DIRECT] / max);
+	}
+}
+
+
+void
+multiload_graph_vm_cmdline_output (MultiloadCollector *c, VmData *xd)
+{
+	g_snprintf(c->output_str[0], sizeof(c->output_str[0]), "%"G_GUINT64_FORMAT, xd->rate[VM_PGMAJFAULT]);
+	g_snprintf(c->output_str[1], sizeof(c->output_str[1]), "%"G_GUINT64_FORMAT, xd->rate[VM_PGSCAN_DIRECT]);
+	g_snprintf(c->output_str[2], sizeof(c->output_str[2]), "%"G_GUINT64_FORMAT, xd->rate[VM_PGFAULT]);
+	g_snprintf(c->output_str[3], sizeof(c->output_str[3]), "%"G_GUINT64_FORMAT, xd->rate[VM_ALLOCSTALL]);
+}
+
+
+void
+multiload_graph_vm_tooltip_update (char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, VmData *xd, gint style)
+{
+	if (style == MULTILOAD_TOOLTIP_STYLE_DETAILED) {
+		guint64 scan = xd->rate[VM_PGSCAN_KSWAPD] + xd->rate[VM_PGSCAN_DIRECT];
+		guint64 steal = xd->rate[VM_PGSTEAL_KSWAPD] + xd->rate[VM_PGSTEAL_DIRECT];
+		gchar *efficiency = format_percent(steal, scan, 0);
+
+		g_snprintf(buf_text, len_text, _(	"Page faults: %lu/s (%lu major)\n"
+											"Pages scanned: %lu/s by kswapd, %lu/s direct\n"
+											"Pages reclaimed: %lu/s by kswapd, %lu/s direct\n"
+											"Reclaim efficiency: %s\n"
+											"Allocation stalls: %lu/s\n"
+											"Compaction stalls: %lu/s"),
+											(gulong)xd->rate[VM_PGFAULT], (gulong)xd->rate[VM_PGMAJFAULT],
+											(gulong)xd->rate[VM_PGSCAN_KSWAPD], (gulong)xd->rate[VM_PGSCAN_DIRECT],
+											(gulong)xd->rate[VM_PGSTEAL_KSWAPD], (gulong)xd->rate[VM_PGSTEAL_DIRECT],
+											scan > 0 ? efficiency : "-",
+											(gulong)xd->rate[VM_ALLOCSTALL], (gulong)xd->rate[VM_COMPACT_STALL]);
+		g_free(efficiency);
+	} else {
+		g_snprintf(buf_text, len_text, _("%lu major faults/s, %lu direct scans/s"),
+											(gulong)xd->rate[VM_PGMAJFAULT], (gulong)xd->rate[VM_PGSCAN_DIRECT]);
+	}
+}
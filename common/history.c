@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+
+#include "history.h"
+
+
+// number of samples aggregated in each entry of a tier
+static guint
+multiload_history_tier_span (guint tier)
+{
+	guint i, span = 1;
+	for (i = 0; i < tier; i++)
+		span *= MULTILOAD_HISTORY_TIER_FACTOR;
+	return span;
+}
+
+/* Sets pointers inside h->block, following the layout described in header.
+ * 32 bit arrays come first, so everything is aligned. */
+static void
+multiload_history_map (MultiloadHistory *h)
+{
+	MultiloadHistoryHeader *hdr = h->block;
+	guchar *p = (guchar*)h->block + sizeof(MultiloadHistoryHeader);
+	guint t;
+
+	h->header = hdr;
+
+	for (t = 0; t < MULTILOAD_HISTORY_TIERS; t++) {
+		h->scales[t] = (gfloat*)p;
+		p += (gsize)hdr->capacity[t] * hdr->n_scales * sizeof(gfloat);
+	}
+
+	h->pending[0] = NULL;
+	h->pending_scales[0] = NULL;
+	for (t = 1; t < MULTILOAD_HISTORY_TIERS; t++) {
+		h->pending[t] = (MultiloadHistoryPending*)p;
+		p += hdr->n_values * sizeof(MultiloadHistoryPending);
+		h->pending_scales[t] = (gfloat*)p;
+		p += hdr->n_scales * sizeof(gfloat);
+	}
+
+	h->values = (guint16*)p;
+	p += (gsize)hdr->capacity[0] * hdr->n_values * sizeof(guint16);
+
+	h->buckets[0] = NULL;
+	for (t = 1; t < MULTILOAD_HISTORY_TIERS; t++) {
+		h->buckets[t] = (MultiloadHistoryBucket*)p;
+		p += (gsize)hdr->capacity[t] * hdr->n_values * sizeof(MultiloadHistoryBucket);
+	}
+
+	g_assert((gsize)(p - (guchar*)h->block) == h->block_size);
+}
+
+/* Capacity is the number of samples at full resolution. Other tiers have half
+ * the entries, each one covering more samples. */
+static void
+multiload_history_init_header (MultiloadHistoryHeader *hdr, guint graph_id, guint interval, guint n_values, guint n_scales, guint capacity)
+{
+	guint t;
+
+	g_assert(n_scales > 0 && n_values % n_scales == 0);
+
+	memset(hdr, 0, sizeof(MultiloadHistoryHeader));
+	hdr->magic = MULTILOAD_HISTORY_MAGIC;
+	hdr->version = MULTILOAD_HISTORY_VERSION;
+	hdr->graph_id = graph_id;
+	hdr->interval = interval;
+	hdr->n_values = n_values;
+	hdr->n_scales = n_scales;
+	hdr->capacity[0] = MAX(capacity, 1);
+	for (t = 1; t < MULTILOAD_HISTORY_TIERS; t++)
+		hdr->capacity[t] = MAX(capacity / 2, 1);
+}
+
+static gsize
+multiload_history_get_block_size (MultiloadHistoryHeader *hdr)
+{
+	gsize size;
+	guint t;
+
+	size = sizeof(MultiloadHistoryHeader)
+		+ (gsize)hdr->capacity[0] * (hdr->n_values * sizeof(guint16) + hdr->n_scales * sizeof(gfloat));
+	for (t = 1; t < MULTILOAD_HISTORY_TIERS; t++) {
+		size += (gsize)hdr->capacity[t] * (hdr->n_values * sizeof(MultiloadHistoryBucket) + hdr->n_scales * sizeof(gfloat));
+		size += hdr->n_values * sizeof(MultiloadHistoryPending) + hdr->n_scales * sizeof(gfloat);
+	}
+	return size;
+}
+
+MultiloadHistory*
+multiload_history_new (guint graph_id, guint interval, guint n_values, guint n_scales, guint capacity)
+{
+	MultiloadHistoryHeader hdr;
+	MultiloadHistory *h;
+
+	multiload_history_init_header(&hdr, graph_id, interval, n_values, n_scales, capacity);
+
+	h = g_new0(MultiloadHistory, 1);
+	h->fd = -1;
+	h->block_size = multiload_history_get_block_size(&hdr);
+	h->block = g_malloc0(h->block_size);
+	memcpy(h->block, &hdr, sizeof(hdr));
+	multiload_history_map(h);
+
+	g_debug("[history] Created history of %u samples (%"G_GSIZE_FORMAT" bytes)", capacity, h->block_size);
+	return h;
+}
+
+/* Samples missed while nobody was writing the file are recorded as empty, so
+ * restored samples appear at the right distance from new ones. */
+static void
+multiload_history_fill_gap (MultiloadHistory *h)
+{
+	MultiloadHistoryHeader *hdr = h->header;
+	guint last = MULTILOAD_HISTORY_TIERS - 1;
+	guint16 *values;
+	gfloat *scales;
+	gint64 missed;
+
+	if (hdr->length[0] == 0)
+		return;
+
+	// beyond the span of the last tier nothing would be left
+	missed = (g_get_real_time() - hdr->time) / (hdr->interval * (gint64)1000);
+	if (missed < 0 || missed >= (gint64)hdr->capacity[last] * multiload_history_tier_span(last)) {
+		multiload_history_clear(h);
+		return;
+	}
+
+	values = g_new0(guint16, hdr->n_values);
+	scales = g_new0(gfloat, hdr->n_scales);
+	while (missed-- > 0)
+		multiload_history_push(h, values, scales);
+	g_free(values);
+	g_free(scales);
+}
+
+/* Checks whether a file header was written with the same parameters as hdr,
+ * and whether its counters and time can be trusted. Anything else (settings
+ * changes, corrupted or hand edited files) makes the file reset. */
+static gboolean
+multiload_history_header_valid (const MultiloadHistoryHeader *old, const MultiloadHistoryHeader *hdr)
+{
+	guint t;
+
+	// compare everything but time and counters
+	if (memcmp(old, hdr, G_STRUCT_OFFSET(MultiloadHistoryHeader, time)) != 0
+			|| old->n_values != hdr->n_values || old->n_scales != hdr->n_scales
+			|| memcmp(old->capacity, hdr->capacity, sizeof(hdr->capacity)) != 0)
+		return FALSE;
+
+	// out of range counters would make reads and writes overflow the block
+	for (t = 0; t < MULTILOAD_HISTORY_TIERS; t++) {
+		if (old->head[t] >= old->capacity[t] || old->length[t] > old->capacity[t]
+				|| old->pending[t] >= multiload_history_tier_span(t))
+			return FALSE;
+	}
+
+	// samples from the future would be restored after the gap of a past time
+	if (old->time < 0 || old->time > g_get_real_time())
+		return FALSE;
+
+	return TRUE;
+}
+
+/* Same as multiload_history_new, but the store is a file mapped in memory, so
+ * samples survive restarts. Existing contents are kept when the file was
+ * written with the same parameters, otherwise the file is reset. Returns NULL
+ * if the file cannot be used (e.g. another instance is using it). */
+MultiloadHistory*
+multiload_history_open (const gchar *filename, guint graph_id, guint interval, guint n_values, guint n_scales, guint capacity)
+{
+	MultiloadHistoryHeader hdr, old;
+	MultiloadHistory *h;
+	gpointer block;
+	gsize size;
+	gint fd;
+
+	multiload_history_init_header(&hdr, graph_id, interval, n_values, n_scales, capacity);
+	size = multiload_history_get_block_size(&hdr);
+
+	fd = open(filename, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+	if (fd < 0) {
+		g_debug("[history] Unable to open '%s': %s", filename, g_strerror(errno));
+		return NULL;
+	}
+
+	if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+		g_debug("[history] File '%s' is already in use", filename);
+		close(fd);
+		return NULL;
+	}
+
+	if (pread(fd, &old, sizeof(old), 0) != sizeof(old) || !multiload_history_header_valid(&old, &hdr)) {
+		g_debug("[history] File '%s' does not match current settings or is damaged, resetting it", filename);
+		if (ftruncate(fd, 0) != 0 || pwrite(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr)) {
+			g_debug("[history] Unable to write '%s': %s", filename, g_strerror(errno));
+			close(fd);
+			return NULL;
+		}
+	}
+
+	if (ftruncate(fd, size) != 0) {
+		g_debug("[history] Unable to resize '%s': %s", filename, g_strerror(errno));
+		close(fd);
+		return NULL;
+	}
+
+	block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (block == MAP_FAILED) {
+		g_debug("[history] Unable to map '%s': %s", filename, g_strerror(errno));
+		close(fd);
+		return NULL;
+	}
+
+	h = g_new0(MultiloadHistory, 1);
+	h->fd = fd;
+	h->block = block;
+	h->block_size = size;
+	multiload_history_map(h);
+	multiload_history_fill_gap(h);
+
+	g_debug("[history] Mapped history of %u samples from '%s' (%u restored)", capacity, filename, h->header->length[0]);
+	return h;
+}
+
+void
+multiload_history_free (MultiloadHistory *h)
+{
+	if (h == NULL)
+		return;
+
+	if (h->fd >= 0) {
+		munmap(h->block, h->block_size);
+		close(h->fd);
+	} else {
+		g_free(h->block);
+	}
+	g_free(h);
+}
+
+void
+multiload_history_clear (MultiloadHistory *h)
+{
+	guint t;
+
+	for (t = 0; t < MULTILOAD_HISTORY_TIERS; t++) {
+		h->header->length[t] = 0;
+		h->header->head[t] = 0;
+		h->header->pending[t] = 0;
+	}
+}
+
+static void
+multiload_history_advance (MultiloadHistory *h, guint tier)
+{
+	MultiloadHistoryHeader *hdr = h->header;
+
+	hdr->head[tier] = (hdr->head[tier] + 1) % hdr->capacity[tier];
+	if (hdr->length[tier] < hdr->capacity[tier])
+		hdr->length[tier]++;
+}
+
+static inline guint16
+multiload_history_encode (gfloat value)
+{
+	return (guint16)CLAMP(rintf(value), 0, G_MAXUINT16);
+}
+
+/* Adds a sample to the entry being filled in tier t, and stores the entry
+ * when complete, rescaled to the largest scale of its samples */
+static void
+multiload_history_aggregate (MultiloadHistory *h, guint t, const guint16 *values, const gfloat *scales)
+{
+	MultiloadHistoryHeader *hdr = h->header;
+	MultiloadHistoryPending *acc = h->pending[t];
+	MultiloadHistoryBucket *bucket;
+	gfloat *acc_scales = h->pending_scales[t];
+	guint per_scale = hdr->n_values / hdr->n_scales;
+	guint j, k;
+
+	for (k = 0; k < hdr->n_scales; k++)
+		acc_scales[k] = (hdr->pending[t] == 0) ? scales[k] : MAX(acc_scales[k], scales[k]);
+
+	for (j = 0; j < hdr->n_values; j++) {
+		gfloat scale = scales[j / per_scale];
+		gfloat raw = values[j] * (scale > 0 ? scale : 1);
+
+		if (hdr->pending[t] == 0) {
+			acc[j].min = acc[j].max = acc[j].sum = raw;
+		} else {
+			acc[j].min = MIN(acc[j].min, raw);
+			acc[j].max = MAX(acc[j].max, raw);
+			acc[j].sum += raw;
+		}
+	}
+
+	if (++hdr->pending[t] < multiload_history_tier_span(t))
+		return;
+
+	bucket = h->buckets[t] + (gsize)hdr->head[t] * hdr->n_values;
+	for (j = 0; j < hdr->n_values; j++) {
+		gfloat scale = acc_scales[j / per_scale];
+		gfloat div = (scale > 0) ? scale : 1;
+
+		bucket[j].min = multiload_history_encode(acc[j].min / div);
+		bucket[j].max = multiload_history_encode(acc[j].max / div);
+		bucket[j].avg = multiload_history_encode(acc[j].sum / hdr->pending[t] / div);
+	}
+	memcpy(h->scales[t] + (gsize)hdr->head[t] * hdr->n_scales, acc_scales, hdr->n_scales * sizeof(gfloat));
+	multiload_history_advance(h, t);
+	hdr->pending[t] = 0;
+}
+
+void
+multiload_history_push (MultiloadHistory *h, const guint16 *values, const gfloat *scales)
+{
+	MultiloadHistoryHeader *hdr = h->header;
+	guint t;
+
+	memcpy(h->values + (gsize)hdr->head[0] * hdr->n_values, values, hdr->n_values * sizeof(guint16));
+	memcpy(h->scales[0] + (gsize)hdr->head[0] * hdr->n_scales, scales, hdr->n_scales * sizeof(gfloat));
+	multiload_history_advance(h, 0);
+	hdr->time = g_get_real_time();
+
+	for (t = 1; t < MULTILOAD_HISTORY_TIERS; t++)
+		multiload_history_aggregate(h, t, values, scales);
+}
+
+/* Copies samples from src to dest. Stores with the same layout are copied as
+ * they are, otherwise full resolution samples are pushed again, oldest first
+ * (if dest is smaller, only the most recent samples fit). Samples taken at
+ * another interval or with different series would be shown wrong, so they are
+ * not copied. */
+void
+multiload_history_copy (MultiloadHistory *dest, MultiloadHistory *src)
+{
+	guint16 *values;
+	gfloat *scales;
+	guint age;
+
+	if (dest->header->n_values != src->header->n_values || dest->header->n_scales != src->header->n_scales) {
+		g_debug("[history] Series changed from %u to %u, samples dropped", src->header->n_values, dest->header->n_values);
+		return;
+	}
+	if (dest->header->interval != src->header->interval) {
+		g_debug("[history] Interval changed from %u to %u ms, samples dropped", src->header->interval, dest->header->interval);
+		return;
+	}
+
+	if (memcmp(dest->header->capacity, src->header->capacity, sizeof(src->header->capacity)) == 0) {
+		g_assert(dest->block_size == src->block_size);
+		memcpy(dest->block, src->block, src->block_size);
+		return;
+	}
+
+	values = g_new(guint16, src->header->n_values);
+	scales = g_new(gfloat, src->header->n_scales);
+
+	multiload_history_clear(dest);
+	for (age = MIN(src->header->length[0], dest->header->capacity[0]); age > 0; age--) {
+		multiload_history_get_sample(src, age - 1, 1, MULTILOAD_HISTORY_AVG, values, scales);
+		multiload_history_push(dest, values, scales);
+	}
+
+	g_free(values);
+	g_free(scales);
+}
+
+/* Reads values of samples at given age (0 is the most recent sample), where
+ * each step of age covers zoom samples. Full resolution samples are used when
+ * available and zoom is 1, otherwise the requested statistic comes from the
+ * first tier whose entries cover at least zoom samples and reach that age.
+ * Returns FALSE if history does not go back that far. */
+gboolean
+multiload_history_get_sample (MultiloadHistory *h, guint age, guint zoom, MultiloadHistoryStat stat, guint16 *values, gfloat *scales)
+{
+	MultiloadHistoryHeader *hdr = h->header;
+	MultiloadHistoryBucket *bucket;
+	guint64 samples = (guint64)age * MAX(zoom, 1);
+	gsize i, j;
+	guint t;
+
+	if (zoom <= 1 && age < hdr->length[0]) {
+		i = (hdr->head[0] + hdr->capacity[0] - 1 - age) % hdr->capacity[0];
+		memcpy(values, h->values + i * hdr->n_values, hdr->n_values * sizeof(guint16));
+		memcpy(scales, h->scales[0] + i * hdr->n_scales, hdr->n_scales * sizeof(gfloat));
+		return TRUE;
+	}
+
+	for (t = 1; t < MULTILOAD_HISTORY_TIERS; t++) {
+		guint span = multiload_history_tier_span(t);
+		guint64 entry;
+
+		if (span < zoom && t < MULTILOAD_HISTORY_TIERS - 1)
+			continue;
+
+		// most recent samples are still in the entry being filled
+		entry = (samples < hdr->pending[t]) ? 0 : (samples - hdr->pending[t]) / span;
+		if (entry >= hdr->length[t])
+			continue;
+
+		i = (hdr->head[t] + hdr->capacity[t] - 1 - entry) % hdr->capacity[t];
+		bucket = h->buckets[t] + i * hdr->n_values;
+		for (j = 0; j < hdr->n_values; j++) {
+			switch (stat) {
+				case MULTILOAD_HISTORY_MIN: values[j] = bucket[j].min; break;
+				case MULTILOAD_HISTORY_MAX: values[j] = bucket[j].max; break;
+				default:                    values[j] = bucket[j].avg; break;
+			}
+		}
+		memcpy(scales, h->scales[t] + i * hdr->n_scales, hdr->n_scales * sizeof(gfloat));
+		return TRUE;
+	}
+
+	return FALSE;
+}
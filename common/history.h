@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __MULTILOAD_HISTORY_H__
+#define __MULTILOAD_HISTORY_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+#define MULTILOAD_HISTORY_TIERS 3
+// each entry of tier t aggregates MULTILOAD_HISTORY_TIER_FACTOR^t samples
+#define MULTILOAD_HISTORY_TIER_FACTOR 8
+
+/* Aggregated values of an entry of tiers above 0, as fractions of the scale of
+ * the entry (the largest scale of aggregated samples) */
+typedef struct {
+	guint16 min;
+	guint16 max;
+	guint16 avg;
+} MultiloadHistoryBucket;
+
+// raw values (value multiplied by its scale) of the entry being filled
+typedef struct {
+	gfloat min;
+	gfloat max;
+	gfloat sum;
+} MultiloadHistoryPending;
+
+typedef enum {
+	MULTILOAD_HISTORY_MIN,
+	MULTILOAD_HISTORY_MAX,
+	MULTILOAD_HISTORY_AVG
+} MultiloadHistoryStat;
+
+#define MULTILOAD_HISTORY_MAGIC 0x48544c4d // "MLTH"
+#define MULTILOAD_HISTORY_VERSION 3
+
+/* Stored at the beginning of the data block. When the block is mapped from a
+ * file, this is also the file header. */
+typedef struct {
+	guint32 magic;
+	guint32 version;
+	guint32 graph_id;
+	guint32 interval;	// milliseconds between samples
+	gint64 time;		// wall clock time of the last sample, in microseconds
+	guint32 n_values;
+	guint32 n_scales;
+	guint32 capacity[MULTILOAD_HISTORY_TIERS];
+	guint32 length[MULTILOAD_HISTORY_TIERS];
+	guint32 head[MULTILOAD_HISTORY_TIERS];
+	guint32 pending[MULTILOAD_HISTORY_TIERS];	// samples in entry being filled
+} MultiloadHistoryHeader;
+
+/* Samples of a graph, independent from widget size. Values are 16 bit fixed
+ * point fractions of their scale, as in LoadGraphData. Tier 0 is a ring of
+ * samples at full resolution, higher tiers keep min/max/average of groups of
+ * samples, with half the entries of tier 0, so they reach further back in
+ * time. Everything lives in a single block of memory. */
+typedef struct {
+	MultiloadHistoryHeader *header;
+	gfloat *scales[MULTILOAD_HISTORY_TIERS];
+	guint16 *values;								// tier 0 only
+	MultiloadHistoryBucket *buckets[MULTILOAD_HISTORY_TIERS];	// tier 0 unused
+	MultiloadHistoryPending *pending[MULTILOAD_HISTORY_TIERS];	// tier 0 unused
+	gfloat *pending_scales[MULTILOAD_HISTORY_TIERS];			// tier 0 unused
+
+	gpointer block;
+	gsize block_size;
+	gint fd;	// -1 unless block is mapped from a file
+} MultiloadHistory;
+
+
+G_GNUC_INTERNAL MultiloadHistory*
+multiload_history_new (guint graph_id, guint interval, guint n_values, guint n_scales, guint capacity);
+G_GNUC_INTERNAL MultiloadHistory*
+multiload_history_open (const gchar *filename, guint graph_id, guint interval, guint n_values, guint n_scales, guint capacity);
+G_GNUC_INTERNAL void
+multiload_history_free (MultiloadHistory *h);
+G_GNUC_INTERNAL void
+multiload_history_clear (MultiloadHistory *h);
+G_GNUC_INTERNAL void
+multiload_history_push (MultiloadHistory *h, const guint16 *values, const gfloat *scales);
+G_GNUC_INTERNAL void
+multiload_history_copy (MultiloadHistory *dest, MultiloadHistory *src);
+G_GNUC_INTERNAL gboolean
+multiload_history_get_sample (MultiloadHistory *h, guint age, guint zoom, MultiloadHistoryStat stat, guint16 *values, gfloat *scales);
+
+G_END_DECLS
+
+#endif /* __MULTILOAD_HISTORY_H__ */
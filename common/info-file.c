@@ -22,12 +22,76 @@
 
 #include "info-file.h"
 
+#include <fcntl.h>
 #include <string.h>
 
+/* System files are looked up under this prefix, when set. This way collectors
+ * can read a recorded tree instead of the live system. Set from environment
+ * variable MULTILOAD_SYSROOT at first use, or by info_file_set_sysroot. */
+static gchar *sysroot = NULL;
+static gboolean sysroot_initialized = FALSE;
+
+const gchar*
+info_file_get_sysroot ()
+{
+	if (G_UNLIKELY(!sysroot_initialized))
+		info_file_set_sysroot(g_getenv("MULTILOAD_SYSROOT"));
+
+	return sysroot;
+}
+
+void
+info_file_set_sysroot (const gchar *root)
+{
+	g_free(sysroot);
+	sysroot = NULL;
+	sysroot_initialized = TRUE;
+
+	if (root != NULL && root[0] != '\0') {
+		sysroot = g_strdup(root);
+		g_debug("[info-file] Reading system files under '%s'", sysroot);
+	}
+}
+
+/* Returns path itself when there is no sysroot, else the prefixed path is
+ * written in buf (at least PATH_MAX bytes) and returned. */
+const gchar*
+info_file_path (const gchar *path, gchar *buf)
+{
+	const gchar *root = info_file_get_sysroot();
+
+	if (G_LIKELY(root == NULL))
+		return path;
+
+	g_snprintf(buf, PATH_MAX, "%s%s", root, path);
+	return buf;
+}
+
+FILE*
+info_file_fopen (const gchar *path, const gchar *mode)
+{
+	gchar buf[PATH_MAX];
+	return fopen(info_file_path(path, buf), mode);
+}
+
+gint
+info_file_open (const gchar *path, gint flags)
+{
+	gchar buf[PATH_MAX];
+	return open(info_file_path(path, buf), flags);
+}
+
+DIR*
+info_file_opendir (const gchar *path)
+{
+	gchar buf[PATH_MAX];
+	return opendir(info_file_path(path, buf));
+}
+
 FILE*
 info_file_required_fopen (const gchar *path, const gchar *mode)
 {
-	FILE *f = fopen (path, mode);
+	FILE *f = info_file_fopen (path, mode);
 	g_assert (f != NULL);
 	return f;
 }
@@ -35,7 +99,8 @@ info_file_required_fopen (const gchar *path, const gchar *mode)
 gboolean
 info_file_exists (const gchar *path)
 {
-	return g_file_test(path, G_FILE_TEST_EXISTS);
+	gchar buf[PATH_MAX];
+	return g_file_test(info_file_path(path, buf), G_FILE_TEST_EXISTS);
 }
 
 gboolean
@@ -46,7 +111,7 @@ info_file_has_contents (const gchar *path, const gchar *contents, gboolean case_
 
 	gboolean result;
 
-	FILE *f = fopen(path, "r");
+	FILE *f = info_file_fopen(path, "r");
 	if (f == NULL)
 		return FALSE;
 
@@ -75,7 +140,7 @@ info_file_read_string_s (const gchar *path, gchar *buf, const size_t bufsize, si
 	if (path == NULL || buf == NULL || bufsize < 1)
 		return FALSE;
 
-	FILE *f = fopen(path, "r");
+	FILE *f = info_file_fopen(path, "r");
 	if (!f)
 		return FALSE;
 
@@ -102,9 +167,10 @@ info_file_read_string (const gchar *path, gchar **out, size_t *length)
 	if (path == NULL || out == NULL)
 		return FALSE;
 
+	gchar buf[PATH_MAX];
 	size_t n;
 
-	if (!g_file_get_contents (path, out, &n, NULL))
+	if (!g_file_get_contents (info_file_path(path, buf), out, &n, NULL))
 		return FALSE;
 
 	while (n>0 && (*out)[n-1] == '\n') {
@@ -202,7 +268,7 @@ info_file_read_key_string_s (const gchar *path, const gchar *key, gchar *buf, si
 	gchar *line = NULL;
 	size_t n = 0;
 
-	FILE *f = fopen(path, "r");
+	FILE *f = info_file_fopen(path, "r");
 	if (f == NULL)
 		return FALSE;
 
@@ -343,7 +409,7 @@ info_file_read_keys (const gchar *path, const InfoFileMappingEntry *entries, gin
 	int linelen;
 	guint i;
 
-	FILE *f = fopen(path, "r");
+	FILE *f = info_file_fopen(path, "r");
 	if (f == NULL)
 		return -1;
 
@@ -351,7 +417,8 @@ info_file_read_keys (const gchar *path, const InfoFileMappingEntry *entries, gin
 		for (i=0; i<count; i++) {
 			len = strlen(entries[i].key);
 
-			if (strncmp(line, entries[i].key, len) == 0) {
+			// whole key must match (e.g. "Shmem" must not match "ShmemHugePages")
+			if (strncmp(line, entries[i].key, len) == 0 && (line[len] == ':' || g_ascii_isspace(line[len]))) {
 				pch = line+len;
 
 				while (pch-line<linelen) {
@@ -400,6 +467,9 @@ info_file_read_keys (const gchar *path, const InfoFileMappingEntry *entries, gin
 					default:
 						g_assert_not_reached();
 				}
+
+				// a line holds only one key
+				break;
 			}
 		}
 	}
@@ -422,7 +492,7 @@ info_file_count_key_values (const gchar *path, const gchar *key)
 	gchar *line = NULL;
 	size_t n = 0;
 
-	FILE *f = fopen(path, "r");
+	FILE *f = info_file_fopen(path, "r");
 	if (f == NULL)
 		return FALSE;
 
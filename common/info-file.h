@@ -24,6 +24,8 @@
 #define __MULTILOAD_INFO_FILE_H__
 
 #include <glib.h>
+#include <dirent.h>
+#include <limits.h>
 #include <stdio.h>
 
 
@@ -34,6 +36,30 @@ typedef struct {
 } InfoFileMappingEntry;
 
 
+G_GNUC_INTERNAL
+const gchar*
+info_file_get_sysroot ();
+
+G_GNUC_INTERNAL
+void
+info_file_set_sysroot (const gchar *root);
+
+G_GNUC_INTERNAL
+const gchar*
+info_file_path (const gchar *path, gchar *buf);
+
+G_GNUC_INTERNAL
+FILE*
+info_file_fopen (const gchar *path, const gchar *mode);
+
+G_GNUC_INTERNAL
+gint
+info_file_open (const gchar *path, gint flags);
+
+G_GNUC_INTERNAL
+DIR*
+info_file_opendir (const gchar *path);
+
 G_GNUC_INTERNAL
 FILE*
 info_file_required_fopen (const gchar *path, const gchar *mode);
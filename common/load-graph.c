@@ -31,6 +31,7 @@
 #include <gdk/gdkx.h>
 #include <gtk/gtk.h>
 
+#include "autoscaler.h"
 #include "colors.h"
 #include "gtk-compat.h"
 #include "graph-data.h"
@@ -96,21 +97,132 @@ load_graph_cairo_set_gradient(cairo_t *cr, double width, double height, int dire
 	cairo_pattern_destroy (pat);
 }
 
-/* Redraws the backing pixmap for the load graph and updates the window */
+/* Height of graph area in device pixels, without borders */
+static guint
+load_graph_get_area_height (LoadGraph *g)
+{
+	if ((guint)(2*g->config->border_width) < g->draw_height)
+		return (g->draw_height - 2*g->config->border_width) * g->scale;
+	return 0;
+}
+
+/* Computes position of strips inside a graph area of height H. There is a
+ * 1px separator between strips, any remaining space goes below the last one. */
+static void
+load_graph_layout_strips (LoadGraph *g, guint H)
+{
+	guint i;
+
+	g->strip_area = H;
+	if (g->n_strips <= 1 || H < 2*g->n_strips) {
+		g->strip_height = H;
+		g->strip_y[0] = 0;
+		return;
+	}
+
+	g->strip_height = (H - (g->n_strips - 1)) / g->n_strips;
+	for (i = 0; i < g->n_strips; i++)
+		g->strip_y[i] = i * (g->strip_height + 1);
+
+	g_debug("[load-graph] Graph '%s' split in %u strips of %u pixels", graph_types[g->id].name, g->n_strips, g->strip_height);
+}
+
+/* Draws stacked data of a strip (first data row is offset) in given area.
+ * Coordinates are in device pixels, W is the number of columns: each column
+ * is a rectangle g->scale pixels wide. */
 static void
-load_graph_draw (LoadGraph *g)
+load_graph_draw_data (LoadGraph *g, cairo_t *cr, guint x, guint y, guint W, guint H, guint offset)
 {
+	LoadGraphData *d = g->data;
+	guint16 *pos = d->pos[0];
+	guint16 *top = d->pos[1];
+	guint16 *tmp;
+	const guint16 *pixel;
 	guint i, j;
+
+	for (i = 0; i < W; i++)
+		pos[i] = H;
+
+	for (j = 0; j < multiload_config_get_num_data(g->id); j++) {
+		pixel = d->pixel + (offset+j) * d->width;
+
+		// out of scale values end at graph border (loop is vectorized)
+		for (i = 0; i < W; i++)
+			top[i] = (pos[i] > pixel[i]) ? pos[i] - pixel[i] : 0;
+
+		cairo_set_source_rgba_from_config(cr, g->config, j);
+		for (i = 0; i < W; i++) {
+			if (top[i] < pos[i])
+				cairo_rectangle (cr, x + (W - i - 1) * g->scale, y + top[i], g->scale, pos[i] - top[i]);
+		}
+		cairo_fill (cr);
+
+		tmp = pos;
+		pos = top;
+		top = tmp;
+	}
+}
+
+/* Converts stored values to pixel heights (h is the height of each strip).
+ * Values are rescaled to the scale of the latest sample, so when the scale
+ * changes the whole graph is converted again. Otherwise only new columns are
+ * converted, as the others already hold heights for current generation. */
+static void
+load_graph_update_pixels (LoadGraph *g, guint W, guint h)
+{
+	LoadGraphData *d = g->data;
+	guint i, j, s;
+	guint num_data = multiload_config_get_num_data(g->id);
+	gboolean changed = (h != g->display_height);
+
+	for (s = 0; s < g->n_strips; s++) {
+		if (d->scale[s * d->width] != g->display_scale[s]) {
+			g->display_scale[s] = d->scale[s * d->width];
+			changed = TRUE;
+		}
+	}
+
+	if (changed) {
+		g->display_height = h;
+		g->scale_generation++;
+		if (g->scale_generation == 0) // 0 marks columns never converted
+			g->scale_generation = 1;
+	}
+
+	for (i = 0; i < W; i++) {
+		if (d->generation[i] == g->scale_generation)
+			continue;
+
+		for (s = 0; s < g->n_strips; s++) {
+			gfloat scale = d->scale[s * d->width + i];
+			gdouble k = (gdouble)h / (MULTILOAD_COLLECTOR_DATA_ONE >> LOAD_GRAPH_DATA_SHIFT);
+			if (scale > 0 && g->display_scale[s] > 0)
+				k *= scale / g->display_scale[s];
+
+			// anything taller than the graph is drawn the same
+			for (j = s*num_data; j < (s+1)*num_data; j++)
+				d->pixel[j * d->width + i] = MIN(rint(d->value[j * d->width + i] * k), h);
+		}
+		d->generation[i] = g->scale_generation;
+	}
+}
+
+/* Redraws the backing surface of the graph, without touching the window */
+void
+load_graph_render (LoadGraph *g)
+{
+	guint s;
 	guint c_top, c_bottom, c_border;
 	cairo_t *cr;
 	GdkRGBA *colors = g->config->colors;
 
+	// surface is in device pixels, data columns are in logical pixels
+	guint scale = g->scale;
+	guint border = g->config->border_width * scale;
 	guint x = 0;
 	guint y = 0;
-	guint W = g->draw_width;
-	guint H = g->draw_height;
-
-	double line_x, line_y, line_y_dest;
+	guint W = g->draw_width * scale;
+	guint H = g->draw_height * scale;
 
 	/* we might get called before the configure event so that
 	 * g->disp->allocation may not have the correct size
@@ -122,7 +234,6 @@ load_graph_draw (LoadGraph *g)
 	cr = cairo_create (g->surface);
 	cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
 	cairo_set_line_width (cr, 1.0);
-	cairo_set_line_cap (cr, CAIRO_LINE_CAP_SQUARE);
 
 	c_top = multiload_colors_get_extra_index(g->id, EXTRA_COLOR_BACKGROUND_TOP);
 	c_bottom = multiload_colors_get_extra_index(g->id, EXTRA_COLOR_BACKGROUND_BOTTOM);
@@ -130,23 +241,23 @@ load_graph_draw (LoadGraph *g)
 
 
 	// border
-	if (g->config->border_width > 0) {
+	if (border > 0) {
 		cairo_set_source_rgba_from_config(cr, g->config, c_border);
 		cairo_rectangle(cr, 0, 0, W, H);
 		cairo_fill(cr);
 
-		if ((guint)(2*g->config->border_width) < W)
-			W -= 2*g->config->border_width;
+		if (2*border < W)
+			W -= 2*border;
 		else
 			W=0;
 
-		if ((guint)(2*g->config->border_width) < H)
-			H -= 2*g->config->border_width;
+		if (2*border < H)
+			H -= 2*border;
 		else
 			H=0;
 
-		x = g->config->border_width;
-		y = g->config->border_width;
+		x = border;
+		y = border;
 	}
 
 	if (W > 0 && H > 0) {
@@ -156,83 +267,278 @@ load_graph_draw (LoadGraph *g)
 		cairo_fill(cr);
 
 		// graph data
-		for (i = 0; i < W; i++)
-			g->pos[i] = H;
+		if (g->n_strips <= 1) {
+			load_graph_update_pixels(g, W / scale, H);
+			load_graph_draw_data(g, cr, x, y, W / scale, H, 0);
+		} else {
+			if (G_UNLIKELY(g->strip_area != H))
+				load_graph_layout_strips(g, H);
+
+			load_graph_update_pixels(g, W / scale, g->strip_height);
+			for (s = 0; s < g->n_strips; s++)
+				load_graph_draw_data(g, cr, x, y + g->strip_y[s], W / scale, g->strip_height, s * multiload_config_get_num_data(g->id));
+
+			// separators use border color
+			cairo_set_source_rgba_from_config(cr, g->config, c_border);
+			for (s = 1; s < g->n_strips; s++) {
+				cairo_move_to (cr, x, y + g->strip_y[s] - 0.5);
+				cairo_line_to (cr, x + W, y + g->strip_y[s] - 0.5);
+			}
+			cairo_stroke (cr);
+		}
 
-		for (j = 0; j < multiload_config_get_num_data(g->id); j++) {
-			cairo_set_source_rgba_from_config(cr, g->config, j);
-			for (i = 0; i < W; i++) {
-				if (g->data[i][j] == 0)
-					continue;
+		if (G_UNLIKELY(multiload_profile_overlay_enabled())) {
+			cairo_save (cr);
+			cairo_scale (cr, scale, scale);
+			multiload_profile_draw_overlay(&g->profile, cr, x / scale, y / scale, W / scale, H / scale);
+			cairo_restore (cr);
+		}
+	}
 
-				line_x = x + W - i - 0.5;
-				line_y = y + g->pos[i] - 0.5;
-				line_y_dest = line_y - g->data[i][j] + 1;
+	cairo_destroy (cr);
+}
 
-				// Ensure 1px lines are drawn
-				if (g->data[i][j] == 1)
-					line_y_dest -= 1;
+/* Renders the backing surface if data changed since last time */
+static void
+load_graph_render_pending (LoadGraph *g)
+{
+	if (!g->render_pending || g->surface == NULL)
+		return;
 
-				if (line_y > y) { // don't even begin to draw out of scale values
-					if (line_y_dest < y) // makes sure that line ends to graph border
-						line_y_dest = y + 0.5;
+	multiload_profile_begin(&g->profile, MULTILOAD_PROFILE_DRAW);
+	load_graph_render (g);
+	multiload_profile_end(&g->profile, MULTILOAD_PROFILE_DRAW);
 
-					cairo_move_to (cr, line_x, line_y);
-					cairo_line_to (cr, line_x, line_y_dest);
-				}
+	g->render_pending = FALSE;
+}
 
-				g->pos[i] -= g->data[i][j];
-			}
+/* Invalidates the part of the widget that changes with a new sample: the
+ * whole data area scrolls, borders stay the same. Actual drawing happens in
+ * the draw handler, which GTK runs from the frame clock together with other
+ * widgets. */
+static void
+load_graph_queue_draw (LoadGraph *g)
+{
+	guint border = MAX(g->config->border_width, 0);
 
-			cairo_stroke (cr);
-		}
-	}
+	g->render_pending = TRUE;
 
-	cairo_destroy (cr);
+	if (g->disp == NULL)
+		return;
 
-	cr = gdk_cairo_create (gtk_widget_get_window (g->disp));
-	cairo_set_source_surface (cr, g->surface, 0, 0);
-	cairo_paint (cr);
-	cairo_destroy (cr);
+	if (2*border < g->draw_width && 2*border < g->draw_height)
+		gtk_widget_queue_draw_area (g->disp, border, border, g->draw_width - 2*border, g->draw_height - 2*border);
+	else
+		gtk_widget_queue_draw (g->disp);
+}
+
+/* Allocates graph data for given number of columns, zero filled. All arrays
+ * share a single block, to be freed with g_free. */
+static LoadGraphData *
+load_graph_data_new (guint width, guint n_values, guint n_scales)
+{
+	LoadGraphData *d;
+
+	// 32 bit arrays first, so that all of them are aligned
+	d = g_malloc0 (sizeof (LoadGraphData)
+			+ (n_scales + 1) * width * sizeof (guint32)
+			+ (2 * n_values + 2) * width * sizeof (guint16));
+
+	d->width = width;
+	d->n_values = n_values;
+	d->n_scales = n_scales;
+	d->scale = (gfloat*)(d + 1);
+	d->generation = (guint*)(d->scale + n_scales * width);
+	d->value = (guint16*)(d->generation + width);
+	d->pixel = d->value + n_values * width;
+	d->pos[0] = d->pixel + n_values * width;
+	d->pos[1] = d->pos[0] + width;
+	return d;
+}
+
+/* Converts sampled values to the stored format, values out of stored range are
+ * saturated */
+static void
+load_graph_encode (const gint *values, guint16 *out, guint n)
+{
+	guint r;
+
+	for (r = 0; r < n; r++)
+		out[r] = CLAMP(values[r], 0, G_MAXUINT16 << LOAD_GRAPH_DATA_SHIFT) >> LOAD_GRAPH_DATA_SHIFT;
+}
+
+/* Stores a sample (already in stored format) in column i */
+static void
+load_graph_data_set_column (LoadGraphData *d, guint i, const guint16 *values, const gfloat *scales)
+{
+	guint r;
+
+	for (r = 0; r < d->n_values; r++)
+		d->value[r * d->width + i] = values[r];
+	for (r = 0; r < d->n_scales; r++)
+		d->scale[r * d->width + i] = scales[r];
+	d->generation[i] = 0;
 }
 
-/* Rotates graph data to the right */
+/* Fills columns from first to last (excluded) with samples from history. When
+ * the graph is wider than full resolution history, older columns get averages
+ * of aggregated samples. History only holds strips in use, other rows stay
+ * zero. */
 static void
-load_graph_rotate (LoadGraph *g)
+load_graph_data_restore (LoadGraph *g, guint first, guint last)
 {
+	guint16 values[MAX_COLORS * MAX_STRIPS] = { 0 };
+	gfloat scales[MAX_STRIPS] = { 0 };
 	guint i;
-	gint* tmp;
 
-	tmp = g->data[g->draw_width - 1];
-	for(i = g->draw_width - 1; i > 0; --i)
-		g->data[i] = g->data[i-1];
-	g->data[0] = tmp;
+	if (g->history == NULL)
+		return;
+
+	for (i = first; i < last; i++) {
+		if (!multiload_history_get_sample(g->history, i, 1, MULTILOAD_HISTORY_AVG, values, scales))
+			break;
+		load_graph_data_set_column(g->data, i, values, scales);
+	}
+}
+
+/* Scrolls graph data to the right, and stores the new sample in column 0.
+ * Rows of unused strips are always zero, so they are left alone. */
+void
+load_graph_push (LoadGraph *g, const gint *values, const gfloat *scales)
+{
+	LoadGraphData *d = g->data;
+	guint16 column[MAX_COLORS * MAX_STRIPS];
+	guint rows = multiload_config_get_num_data(g->id) * g->n_strips;
+	guint r;
+
+	for (r = 0; r < rows; r++)
+		memmove(d->value + r * d->width + 1, d->value + r * d->width, (d->width - 1) * sizeof (guint16));
+	for (r = 0; r < g->n_strips; r++)
+		memmove(d->scale + r * d->width + 1, d->scale + r * d->width, (d->width - 1) * sizeof (gfloat));
+	memmove(d->generation + 1, d->generation, (d->width - 1) * sizeof (guint));
+
+	// pixel cache needs to follow values
+	for (r = 0; r < rows; r++)
+		memmove(d->pixel + r * d->width + 1, d->pixel + r * d->width, (d->width - 1) * sizeof (guint16));
+
+	load_graph_encode(values, column, d->n_values);
+	load_graph_data_set_column(d, 0, column, scales);
+}
+
+/* Sets the number of strips drawn in the graph. Existing data is discarded,
+ * as it refers to the old strips, and replaced with history of the new ones
+ * if any. Layout is computed here and after resizes only. */
+void
+load_graph_set_strips (LoadGraph *g, guint n)
+{
+	n = CLAMP(n, 1, g->collector->strip_max);
+	if (n == g->n_strips)
+		return;
+
+	g->n_strips = n;
+
+	if (g->allocated) {
+		LoadGraphData *d = g->data;
+		memset(d->value, 0, d->n_values * d->width * sizeof (guint16));
+		memset(d->scale, 0, d->n_scales * d->width * sizeof (gfloat));
+		memset(d->generation, 0, d->width * sizeof (guint));
+	}
+
+	// history only holds strips in use
+	if (g->history != NULL) {
+		load_graph_setup_history(g);
+		if (g->allocated)
+			load_graph_data_restore(g, 0, g->draw_width);
+	}
+
+	load_graph_layout_strips(g, load_graph_get_area_height(g));
 }
 
 
+/* Allocates a sample for values of all strips. Values and scales share a
+ * single block, to be freed with g_free. */
+LoadGraphColumn *
+load_graph_column_new (LoadGraph *g)
+{
+	guint n = multiload_config_get_num_data(g->id) * g->collector->strip_max;
+	LoadGraphColumn *c = g_malloc0 (sizeof (LoadGraphColumn) + n * sizeof (gint) + g->collector->strip_max * sizeof (gfloat));
+
+	c->scale = (gfloat*)(c->value + n);
+	return c;
+}
+
+/* Collectors do not know about graph configuration, they get a copy of the
+ * settings they use before each sample. */
+static void
+load_graph_sync_collector (LoadGraph *g)
+{
+	MultiloadCollector *collector = g->collector;
+
+	collector->interval = g->config->interval;
+	collector->width = g->draw_width;
+	collector->filter_enable = g->config->filter_enable;
+	collector->size_format_iec = g->multiload->size_format_iec;
+	collector->autoscaler_percentile = g->multiload->autoscaler_percentile;
+	collector->cgroup = g->multiload->cgroup;
+}
+
+/* Takes a new sample into column c, and records it in history and export
+ * stream. Does not draw anything, so it works for headless graphs too. */
+void
+load_graph_collect (LoadGraph *g, LoadGraphColumn *c)
+{
+	MultiloadCollector *collector = g->collector;
+	guint n_values = multiload_config_get_num_data(g->id) * collector->strip_max;
+	gint values[MAX_COLORS * MAX_STRIPS];
+	guint16 column[MAX_COLORS * MAX_STRIPS];
+	guint i;
+
+	load_graph_sync_collector(g);
+	memset(values, 0, n_values * sizeof(values[0]));
+	multiload_profile_begin(&g->profile, MULTILOAD_PROFILE_SAMPLE);
+	multiload_collector_sample(collector, values);
+	multiload_profile_end(&g->profile, MULTILOAD_PROFILE_SAMPLE);
+
+	// this clears all columns, so sample is stored afterwards
+	if (collector->n_strips != g->n_strips)
+		load_graph_set_strips(g, collector->n_strips);
+
+	memcpy(c->value, values, n_values * sizeof(values[0]));
+	for (i = 0; i < collector->strip_max; i++)
+		c->scale[i] = collector->scale[i];
+
+	if (g->history != NULL) {
+		load_graph_encode(c->value, column, g->history->header->n_values);
+		multiload_history_push(g->history, column, c->scale);
+	}
+	if (g->multiload->export != NULL)
+		multiload_export_write(g->multiload->export, g->id, g_get_monotonic_time(),
+				c->value, multiload_config_get_num_data(g->id) * g->n_strips, c->scale, g->n_strips);
+}
+
 /* Updates the load graph when the timeout expires */
 static gboolean
 load_graph_update (LoadGraph *g)
 {
-
 	if (g->data == NULL)
 		return TRUE;
 
-	load_graph_rotate(g);
-
-	g_assert(g->multiload->extra_data != NULL);
-	guint H = g->draw_height - 2 * (g->multiload->graph_config[g->id].border_width);
-	graph_types[g->id].get_data(H, g->data [0], g, g->multiload->extra_data[g->id], g->first_update);
-
-	g->first_update = FALSE;
+	load_graph_collect(g, g->sample);
+	load_graph_push(g, g->sample->value, g->sample->scale);
 
-	if (g->tooltip_update)
+	if (g->collector->tooltip_update) {
+		multiload_profile_begin(&g->profile, MULTILOAD_PROFILE_TOOLTIP);
 		multiload_tooltip_update(g);
+		multiload_profile_end(&g->profile, MULTILOAD_PROFILE_TOOLTIP);
+	}
 
-	load_graph_draw(g);
+	load_graph_queue_draw(g);
 
-	if (g->update_cb)
+	// callbacks may use the surface right away
+	if (g->update_cb) {
+		load_graph_render_pending(g);
 		g->update_cb(g, g->update_cb_user_data);
+	}
 
 	return TRUE;
 }
@@ -240,19 +546,14 @@ load_graph_update (LoadGraph *g)
 void
 load_graph_unalloc (LoadGraph *g)
 {
-	guint i;
-
 	if (!g->allocated)
 		return;
 
-	for (i = 0; i < g->draw_width; i++)
-		g_free (g->data [i]);
-
 	g_free (g->data);
-	g_free (g->pos);
+	g_free (g->sample);
 
-	g->pos = NULL;
 	g->data = NULL;
+	g->sample = NULL;
 
 	if (g->surface) {
 		cairo_surface_destroy (g->surface);
@@ -266,53 +567,146 @@ load_graph_unalloc (LoadGraph *g)
 static void
 load_graph_alloc (LoadGraph *g)
 {
-	guint i;
-
 	if (g->allocated)
 		return;
 
-	g->data = g_new0 (gint *, g->draw_width);
-	g->pos = g_new0 (guint, g->draw_width);
-
-	guint data_size = sizeof (guint) * multiload_config_get_num_data(g->id);
+	g->data = load_graph_data_new (g->draw_width, multiload_config_get_num_data(g->id) * g->collector->strip_max, g->collector->strip_max);
+	g->sample = load_graph_column_new (g);
+	g->display_height = 0;
+	g->profile.allocs++;
 
-	for (i = 0; i < g->draw_width; i++)
-		g->data [i] = g_malloc0 (data_size);
+	// restore as much as possible from history
+	load_graph_data_restore (g, 0, g->draw_width);
 
 	g->allocated = TRUE;
 	g_debug("[load-graph] Graph '%s' allocated", graph_types[g->id].name);
 }
 
-static gint
-load_graph_configure (GtkWidget *widget, GdkEventConfigure *event, LoadGraph *g)
+/* Changes number of data columns. Surviving columns are kept (heights are
+ * converted again on next draw if needed), new ones are filled from history
+ * when possible. */
+static void
+load_graph_set_columns (LoadGraph *g, guint width)
 {
-	GtkAllocation allocation;
+	LoadGraphData *old = g->data;
+	guint n = MIN(width, old->width);
+	guint r;
+
+	g->data = load_graph_data_new (width, old->n_values, old->n_scales);
+	for (r = 0; r < old->n_values; r++)
+		memcpy (g->data->value + r * width, old->value + r * old->width, n * sizeof (guint16));
+	for (r = 0; r < old->n_scales; r++)
+		memcpy (g->data->scale + r * width, old->scale + r * old->width, n * sizeof (gfloat));
+	g_free (old);
+
+	load_graph_data_restore (g, n, width);
+
+	g_debug("[load-graph] Graph '%s' resized from %u to %u columns", graph_types[g->id].name, g->draw_width, width);
+	g->draw_width = width;
+	g->profile.allocs++;
+}
+
+/* Adapts graph data and surface to a new drawing size. Configure events come
+ * often with unchanged size (panel relayouts, theme changes), so buffers are
+ * only touched when their size changes. Widgets are not needed, so this can
+ * be used to draw offscreen too. */
+void
+load_graph_set_draw_size (LoadGraph *g, guint width, guint height)
+{
+	gboolean changed = FALSE;
+
+	width = MAX (width, 1);
+	height = MAX (height, 1);
+
+	if (!g->allocated) {
+		g->draw_width = width;
+		g->draw_height = height;
+		load_graph_alloc (g);
+		changed = TRUE;
+	} else if (width != g->draw_width) {
+		load_graph_set_columns (g, width);
+		changed = TRUE;
+	}
+
+	if (height != g->draw_height) {
+		g->draw_height = height;
+		changed = TRUE;
+	}
 
-	load_graph_unalloc (g);
+	if (g->strip_area != load_graph_get_area_height(g))
+		load_graph_layout_strips (g, load_graph_get_area_height(g));
 
-	gtk_widget_get_allocation (g->disp, &allocation);
+	if (g->surface != NULL && (cairo_image_surface_get_width(g->surface) != (gint)(width * g->scale) || cairo_image_surface_get_height(g->surface) != (gint)(height * g->scale))) {
+		cairo_surface_destroy (g->surface);
+		g->surface = NULL;
+	}
+	if (!g->surface) {
+		g->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width * g->scale, height * g->scale);
+		g->profile.allocs++;
+		changed = TRUE;
+	}
 
-	g->draw_width = allocation.width;
-	g->draw_height = allocation.height;
-	g->draw_width = MAX (g->draw_width, 1);
-	g->draw_height = MAX (g->draw_height, 1);
+	if (changed)
+		g->render_pending = TRUE;
+}
 
-	g_debug("[load-graph] widget allocation for graph '%s': [%d,%d] resulting draw size: [%d,%d]", graph_types[g->id].name, allocation.width, allocation.height, g->draw_width, g->draw_height);
+/* Device pixels per logical pixel of the widget */
+static guint
+load_graph_get_scale_factor (LoadGraph *g)
+{
+#if GTK_API == 3 && GTK_CHECK_VERSION(3,10,0)
+	// offscreen hosts (systray, indicator) copy surfaces at logical size
+	if (GTK_IS_OFFSCREEN_WINDOW(gtk_widget_get_toplevel(g->disp)))
+		return 1;
+	return MAX(gtk_widget_get_scale_factor(g->disp), 1);
+#else
+	return 1;
+#endif
+}
 
-	load_graph_alloc (g);
+static void
+load_graph_update_size (LoadGraph *g)
+{
+	GtkAllocation allocation;
 
-	if (!g->surface)
-		g->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
-												g->draw_width, g->draw_height);
+	gtk_widget_get_allocation (g->disp, &allocation);
+	g->scale = load_graph_get_scale_factor (g);
+	load_graph_set_draw_size (g, allocation.width, allocation.height);
 
-	gtk_widget_queue_draw (widget);
+	g_debug("[load-graph] widget allocation for graph '%s': [%d,%d] resulting draw size: [%d,%d] scale %u", graph_types[g->id].name, allocation.width, allocation.height, g->draw_width, g->draw_height, g->scale);
 
+	gtk_widget_queue_draw (g->disp);
+}
+
+static gint
+load_graph_configure (GtkWidget *widget, GdkEventConfigure *event, LoadGraph *g)
+{
+	load_graph_update_size (g);
 	return TRUE;
 }
-/*
+
+#if GTK_API == 3 && GTK_CHECK_VERSION(3,10,0)
+/* Moving to a monitor with different scale does not change allocation */
+static void
+load_graph_scale_factor_cb (GtkWidget *widget, GParamSpec *pspec, LoadGraph *g)
+{
+	if (g->scale != load_graph_get_scale_factor (g))
+		load_graph_update_size (g);
+}
+#endif
+
+/* cr is already clipped to the invalidated area */
 static gboolean
 load_graph_draw_cb (GtkWidget *widget, cairo_t *cr, LoadGraph *g)
 {
+	if (g->surface == NULL)
+		return FALSE;
+
+	load_graph_render_pending (g);
+
+	// surface is in device pixels
+	if (g->scale > 1)
+		cairo_scale (cr, 1.0 / g->scale, 1.0 / g->scale);
 	cairo_set_source_surface (cr, g->surface, 0, 0);
 	cairo_paint (cr);
 
@@ -324,12 +718,13 @@ static gboolean
 load_graph_expose (GtkWidget *widget, GdkEventExpose *event, LoadGraph *g)
 {
 	cairo_t *cr = gdk_cairo_create (event->window);
+	gdk_cairo_region (cr, event->region);
+	cairo_clip (cr);
 	load_graph_draw_cb(widget, cr, g);
 	cairo_destroy (cr);
 	return FALSE;
 }
 #endif
-*/
 
 static void
 load_graph_destroy (GtkWidget *widget, LoadGraph *g)
@@ -347,16 +742,16 @@ static gchar* parse_cmdline(const gchar* cmdline, LoadGraph *g) {
 	// Once other replacements are done, convert back invalid UTF-8 character to escaped percent
 	gchar percent_escape[] = "\xff";
 
-	g_assert(g->multiload->extra_data != NULL);
-	graph_types[g->id].cmdline_output(g, g->multiload->extra_data[g->id]);
+	g_assert(g->collector != NULL);
+	graph_types[g->id].cmdline_output(g->collector, g->collector->data);
 
 	const gchar *subst_table[][2] = {
 		{ "%%",				percent_escape },
 		{ "%x",				graph_types[g->id].name },
-		{ "%1",				g->output_str[0] },
-		{ "%2",				g->output_str[1] },
-		{ "%3",				g->output_str[2] },
-		{ "%4",				g->output_str[3] },
+		{ "%1",				g->collector->output_str[0] },
+		{ "%2",				g->collector->output_str[1] },
+		{ "%3",				g->collector->output_str[2] },
+		{ "%4",				g->collector->output_str[3] },
 		{ "%u",				graph_types[g->id].output_unit }, // leave that for last, as it can contain '%'s
 		{ percent_escape,	"%" }
 	};
@@ -406,31 +801,44 @@ load_graph_clicked (GtkWidget *widget, GdkEventButton *event, LoadGraph *g)
 static gboolean
 load_graph_mouse_move_cb(GtkWidget *widget, GdkEventCrossing *event, LoadGraph *g)
 {
-	g->tooltip_update = (event->type == GDK_ENTER_NOTIFY);
+	g->collector->tooltip_update = (event->type == GDK_ENTER_NOTIFY);
 	g_debug("[load-graph] Mouse %s event on graph '%s'", (event->type == GDK_ENTER_NOTIFY)?"enter":"leave", graph_types[g->id].name);
 	return GDK_EVENT_PROPAGATE;
 }
 
+/* Graph without widgets, that can only be sampled with load_graph_collect.
+ * GTK does not need to be initialized. */
 LoadGraph *
-load_graph_new (MultiloadPlugin *ma, guint id)
+load_graph_new_headless (MultiloadPlugin *ma, guint id)
 {
 	LoadGraph *g;
 
 	g = g_new0 (LoadGraph, 1);
 	g->id = id;
 
-	g->tooltip_update = FALSE;
 	g->multiload = ma;
 	g->config = &ma->graph_config[id];
 
+	g->timer_index = -1;
+	g->scale = 1;
+
+	g->collector = multiload_collector_new(id);
+	g->collector->filter = g->config->filter;
+	g->n_strips = 1;
+
+	return g;
+}
+
+LoadGraph *
+load_graph_new (MultiloadPlugin *ma, guint id)
+{
+	LoadGraph *g = load_graph_new_headless (ma, id);
+
 	g->main_widget = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
 
 	g->box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
 	gtk_box_pack_start (GTK_BOX (g->main_widget), g->box, TRUE, TRUE, 0);
 
-	g->timer_index = -1;
-	g->first_update = TRUE;
-
 	load_graph_resize(g);
 
 	g->disp = gtk_drawing_area_new ();
@@ -440,12 +848,14 @@ load_graph_new (MultiloadPlugin *ma, guint id)
 						GDK_LEAVE_NOTIFY_MASK |
 						GDK_BUTTON_PRESS_MASK);
 
-/*	//TODO: is this really needed? Works perfectly without (as drawing is done through timers)
 	#if GTK_API == 2
 		g_signal_connect (G_OBJECT(g->disp), "expose_event", G_CALLBACK (load_graph_expose), g);
 	#elif GTK_API == 3
 		g_signal_connect (G_OBJECT(g->disp), "draw", G_CALLBACK (load_graph_draw_cb), g);
-	#endif */
+	#endif
+	#if GTK_API == 3 && GTK_CHECK_VERSION(3,10,0)
+		g_signal_connect (G_OBJECT(g->disp), "notify::scale-factor", G_CALLBACK (load_graph_scale_factor_cb), g);
+	#endif
 	g_signal_connect (G_OBJECT(g->disp), "configure_event", G_CALLBACK (load_graph_configure), g);
 	g_signal_connect (G_OBJECT(g->main_widget), "destroy", G_CALLBACK (load_graph_destroy), g);
 	g_signal_connect (G_OBJECT(g->disp), "button-press-event", G_CALLBACK (load_graph_clicked), g);
@@ -478,11 +888,81 @@ load_graph_resize (LoadGraph *g)
 	g_debug("[load-graph] Set size request of graph '%s' to [%d, %d]", graph_types[g->id].name, w, h);
 }
 
+/* Persistent history is kept in the cache dir, one file per graph and number
+ * of strips, so that strips set up by the first sample find their samples */
+static MultiloadHistory*
+load_graph_open_history (LoadGraph *g, guint interval, guint n_values, guint capacity)
+{
+	MultiloadHistory *h;
+	gchar *dir, *filename;
+
+	dir = g_build_filename(g_get_user_cache_dir(), "multiload-ng", "history", NULL);
+	if (g_mkdir_with_parents(dir, 0700) != 0) {
+		g_debug("[load-graph] Unable to create directory '%s'", dir);
+		g_free(dir);
+		return NULL;
+	}
+
+	if (g->n_strips > 1)
+		filename = g_strdup_printf("%s/%s-%u", dir, graph_types[g->id].name, g->n_strips);
+	else
+		filename = g_strdup_printf("%s/%s", dir, graph_types[g->id].name);
+	h = multiload_history_open(filename, g->id, interval, n_values, g->n_strips, capacity);
+
+	g_free(filename);
+	g_free(dir);
+	return h;
+}
+
+/* Creates history store, or replaces it when its size, interval, strips or
+ * backend must change. Samples that fit in the new store are kept, unless
+ * they were taken at a different interval or with other strips. */
+void
+load_graph_setup_history (LoadGraph *g)
+{
+	MultiloadHistory *h = NULL, *old = g->history;
+	guint interval = CLAMP(g->config->interval, MIN_INTERVAL, MAX_INTERVAL);
+	guint capacity = (guint64)g->multiload->history_retention * 60000 / interval;
+	guint n_values = multiload_config_get_num_data(g->id) * g->n_strips;
+	gboolean persist = g->multiload->history_persist;
+
+	if (capacity == 0) {
+		multiload_history_free(g->history);
+		g->history = NULL;
+		return;
+	}
+
+	if (old != NULL && old->header->capacity[0] == capacity && old->header->interval == interval
+			&& old->header->n_values == n_values && (old->fd >= 0) == persist)
+		return;
+
+	// file may be the same, so release it before opening it again
+	if (old != NULL && old->fd >= 0) {
+		h = multiload_history_new(g->id, old->header->interval, old->header->n_values, old->header->n_scales, old->header->capacity[0]);
+		multiload_history_copy(h, old);
+		multiload_history_free(old);
+		old = h;
+	}
+
+	h = persist ? load_graph_open_history(g, interval, n_values, capacity) : NULL;
+	if (h == NULL)
+		h = multiload_history_new(g->id, interval, n_values, g->n_strips, capacity);
+
+	if (old != NULL) {
+		multiload_history_copy(h, old);
+		multiload_history_free(old);
+	}
+	g->history = h;
+
+	g_debug("[load-graph] History of graph '%s' set to %u samples", graph_types[g->id].name, capacity);
+}
+
 void
 load_graph_start (LoadGraph *g)
 {
 	guint interval = CLAMP(g->config->interval, MIN_INTERVAL, MAX_INTERVAL);
 	load_graph_stop(g);
+	load_graph_setup_history(g);
 	g->timer_index = g_timeout_add (interval, (GSourceFunc) load_graph_update, g);
 	g_debug("[load-graph] Timer started for graph '%s' (interval: %d ms)", graph_types[g->id].name, interval);
 }
@@ -30,15 +30,31 @@ G_BEGIN_DECLS
 
 G_GNUC_INTERNAL LoadGraph*
 load_graph_new (MultiloadPlugin *ma, guint id);
+G_GNUC_INTERNAL LoadGraph*
+load_graph_new_headless (MultiloadPlugin *ma, guint id);
+G_GNUC_INTERNAL LoadGraphColumn*
+load_graph_column_new (LoadGraph *g);
+G_GNUC_INTERNAL void
+load_graph_collect (LoadGraph *g, LoadGraphColumn *c);
+G_GNUC_INTERNAL void
+load_graph_push (LoadGraph *g, const gint *values, const gfloat *scales);
 G_GNUC_INTERNAL void
 load_graph_resize (LoadGraph *g);
 G_GNUC_INTERNAL void
+load_graph_set_draw_size (LoadGraph *g, guint width, guint height);
+G_GNUC_INTERNAL void
+load_graph_render (LoadGraph *g);
+G_GNUC_INTERNAL void
 load_graph_start (LoadGraph *g);
 G_GNUC_INTERNAL void
 load_graph_stop (LoadGraph *g);
 G_GNUC_INTERNAL void
 load_graph_unalloc (LoadGraph *g);
 G_GNUC_INTERNAL void
+load_graph_set_strips (LoadGraph *g, guint n);
+G_GNUC_INTERNAL void
+load_graph_setup_history (LoadGraph *g);
+G_GNUC_INTERNAL void
 load_graph_cairo_set_gradient(cairo_t *cr, double width, double height, int direction, GdkRGBA *a, GdkRGBA *b);
 
 G_END_DECLS
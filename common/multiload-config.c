@@ -22,7 +22,8 @@
 
 #include <config.h>
 
-#include "colors.h"
+#include <string.h>
+
 #include "graph-data.h"
 #include "multiload-config.h"
 
@@ -45,6 +46,7 @@ void multiload_config_init()
 	GraphType temp[] = {
 		{	"cpu",	_("Processor"),		7,	-1,		-1,		"%",
 			(GraphInitFunc)				multiload_graph_cpu_init,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_cpu_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_cpu_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_cpu_cmdline_output,
@@ -52,6 +54,7 @@ void multiload_config_init()
 		},
 		{	"mem",	_("Memory"),		6,	-1,		-1,		"byte",
 			(GraphInitFunc)				NULL,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_mem_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_mem_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_mem_cmdline_output,
@@ -59,13 +62,15 @@ void multiload_config_init()
 		},
 		{	"net",	_("Network"),		6,	-1,		500,	"Bps",
 			(GraphInitFunc)				multiload_graph_net_init,
+			(GraphFreeFunc)				multiload_graph_net_free,
 			(GraphGetDataFunc)			multiload_graph_net_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_net_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_net_cmdline_output,
 			(GraphGetFilterFunc)		multiload_graph_net_get_filter
 		},
-		{	"swap",	_("Swap"),			4,	-1,		-1,		"byte",
-			(GraphInitFunc)				NULL,
+		{	"swap",	_("Swap"),			6,	-1,		8,		"byte",
+			(GraphInitFunc)				multiload_graph_swap_init,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_swap_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_swap_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_swap_cmdline_output,
@@ -73,6 +78,7 @@ void multiload_config_init()
 		},
 		{	"load",	_("Load average"),	4,	8,		3,		"",
 			(GraphInitFunc)				multiload_graph_load_init,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_load_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_load_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_load_cmdline_output,
@@ -80,6 +86,7 @@ void multiload_config_init()
 		},
 		{	"disk",	_("Disk"),			5,	-1,		500,	"Bps",
 			(GraphInitFunc)				NULL,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_disk_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_disk_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_disk_cmdline_output,
@@ -87,6 +94,7 @@ void multiload_config_init()
 		},
 		{	"temp",	_("Temperature"),	5,	120,	60,		"°C",
 			(GraphInitFunc)				multiload_graph_temp_init,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_temp_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_temp_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_temp_cmdline_output,
@@ -94,6 +102,7 @@ void multiload_config_init()
 		},
 		{	"bat",	_("Battery"),		6,	-1,		-1,		"%",
 			(GraphInitFunc)				multiload_graph_bat_init,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_bat_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_bat_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_bat_cmdline_output,
@@ -101,10 +110,27 @@ void multiload_config_init()
 		},
 		{	"parm",	_("Parametric"),	7,	-1,		-1,		"",
 			(GraphInitFunc)				NULL,
+			(GraphFreeFunc)				NULL,
 			(GraphGetDataFunc)			multiload_graph_parm_get_data,
 			(GraphTooltipUpdateFunc)	multiload_graph_parm_tooltip_update,
 			(GraphCmdlineOutputFunc)	multiload_graph_parm_cmdline_output,
 			(GraphGetFilterFunc)		NULL
+		},
+		{	"vm",	_("Paging"),		5,	-1,		10,		"",
+			(GraphInitFunc)				multiload_graph_vm_init,
+			(GraphFreeFunc)				multiload_graph_vm_free,
+			(GraphGetDataFunc)			multiload_graph_vm_get_data,
+			(GraphTooltipUpdateFunc)	multiload_graph_vm_tooltip_update,
+			(GraphCmdlineOutputFunc)	multiload_graph_vm_cmdline_output,
+			(GraphGetFilterFunc)		NULL
+		},
+		{	"sched",_("Scheduler"),		5,	-1,		1000,	"",
+			(GraphInitFunc)				NULL,
+			(GraphFreeFunc)				NULL,
+			(GraphGetDataFunc)			multiload_graph_sched_get_data,
+			(GraphTooltipUpdateFunc)	multiload_graph_sched_tooltip_update,
+			(GraphCmdlineOutputFunc)	multiload_graph_sched_cmdline_output,
+			(GraphGetFilterFunc)		NULL
 		}
 	};
 
@@ -25,20 +25,30 @@
 
 #include <glib.h>
 #include <glib/gi18n-lib.h>
-#include <gtk/gtk.h>
 
+#include "collector.h"
 #include "filter.h"
-#include "gtk-compat.h"
-#include "multiload.h"
 
 
 G_BEGIN_DECLS
 
-typedef void 				(*GraphInitFunc)			(LoadGraph *g, gpointer xd);
-typedef void 				(*GraphGetDataFunc)			(int Maximum, int data[], LoadGraph *g, gpointer xd, gboolean first_call);
-typedef void				(*GraphTooltipUpdateFunc)	(char *buf_title, size_t len_title, char *buf_text, size_t len_text, LoadGraph *g, gpointer xd, gint style);
-typedef void				(*GraphCmdlineOutputFunc)	(LoadGraph *g, gpointer xd);
-typedef MultiloadFilter*	(*GraphGetFilterFunc)		(LoadGraph *g, gpointer xd);
+#define MAX_COLORS 8
+
+// colors after graph data colors
+typedef enum {
+	EXTRA_COLOR_BORDER = 0,
+	EXTRA_COLOR_BACKGROUND_TOP,
+	EXTRA_COLOR_BACKGROUND_BOTTOM,
+
+	EXTRA_COLORS
+} MultiloadExtraColor;
+
+typedef void 				(*GraphInitFunc)			(MultiloadCollector *c, gpointer xd);
+typedef void 				(*GraphFreeFunc)			(MultiloadCollector *c, gpointer xd);
+typedef void 				(*GraphGetDataFunc)			(int Maximum, int data[], MultiloadCollector *c, gpointer xd, gboolean first_call);
+typedef void				(*GraphTooltipUpdateFunc)	(char *buf_title, size_t len_title, char *buf_text, size_t len_text, MultiloadCollector *c, gpointer xd, gint style);
+typedef void				(*GraphCmdlineOutputFunc)	(MultiloadCollector *c, gpointer xd);
+typedef MultiloadFilter*	(*GraphGetFilterFunc)		(MultiloadCollector *c, gpointer xd);
 
 typedef struct _GraphType {
 	const char *name;
@@ -48,6 +58,7 @@ typedef struct _GraphType {
 	const gint scaler_max_floor;	// fixed minimum value of scaler max, or -1 for default
 	const gchar output_unit[10];
 	const GraphInitFunc init;
+	const GraphFreeFunc free;		// releases resources held by xd (not xd itself)
 	const GraphGetDataFunc get_data;
 	const GraphTooltipUpdateFunc tooltip_update;
 	const GraphCmdlineOutputFunc cmdline_output;
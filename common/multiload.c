@@ -49,14 +49,14 @@ multiload_tooltip_update (LoadGraph *g)
 
 	g_assert(g != NULL);
 	g_assert(g->multiload != NULL);
-	g_assert(g->multiload->extra_data != NULL);
+	g_assert(g->collector != NULL);
 	g_assert_cmpuint(g->id, >=, 0);
 	g_assert_cmpuint(g->id,  <, GRAPH_MAX);
 
 	buf_title[0] = '\0';
 	buf_text[0] = '\0';
 
-	graph_types[g->id].tooltip_update(buf_title, sizeof(buf_title), buf_text, sizeof(buf_text), g, g->multiload->extra_data[g->id], g->config->tooltip_style);
+	graph_types[g->id].tooltip_update(buf_title, sizeof(buf_title), buf_text, sizeof(buf_text), g->collector, g->collector->data, g->config->tooltip_style);
 
 	if (buf_text[0] == '\0')
 		g_warning("[multiload] Empty text for tooltip #%d", g->id);
@@ -117,11 +117,41 @@ multiload_start(MultiloadPlugin *ma)
 	}
 
 	multiload_set_order (ma, ma->graph_order);
+	multiload_start_profile_dump (ma);
 
 	g_debug("[multiload] Started %d of %d graphs", n, GRAPH_MAX);
 	return;
 }
 
+static gboolean
+multiload_profile_dump_cb (MultiloadPlugin *ma)
+{
+	gchar buf[200];
+	guint i;
+
+	for (i = 0; i < GRAPH_MAX; i++) {
+		if (ma->graphs[i]->profile.ticks == 0)
+			continue;
+
+		multiload_profile_format(&ma->graphs[i]->profile, buf, sizeof(buf));
+		g_printerr("[profile] %s %s\n", graph_types[i].name, buf);
+	}
+
+	return TRUE;
+}
+
+/* Prints profiling statistics periodically, when requested */
+void
+multiload_start_profile_dump (MultiloadPlugin *ma)
+{
+	guint interval = multiload_profile_get_dump_interval();
+
+	if (interval == 0 || ma->profile_timer != 0)
+		return;
+
+	ma->profile_timer = g_timeout_add_seconds (interval, (GSourceFunc)multiload_profile_dump_cb, ma);
+}
+
 void
 multiload_set_spacing (MultiloadPlugin *ma, gint val)
 {
@@ -137,7 +167,7 @@ multiload_set_padding (MultiloadPlugin *ma, gint val)
 void
 multiload_set_max_value (MultiloadPlugin *ma, guint graph_id, int val)
 {
-	AutoScaler *scaler = multiload_get_scaler(ma, graph_id);
+	AutoScaler *scaler = multiload_collector_get_scaler(ma->graphs[graph_id]->collector);
 	if (scaler == NULL)
 		return;
 	if (val < 0) {
@@ -151,7 +181,7 @@ multiload_set_max_value (MultiloadPlugin *ma, guint graph_id, int val)
 void
 multiload_set_max_floor (MultiloadPlugin *ma, guint graph_id, int val)
 {
-	AutoScaler *scaler = multiload_get_scaler(ma, graph_id);
+	AutoScaler *scaler = multiload_collector_get_scaler(ma->graphs[graph_id]->collector);
 	if (scaler == NULL)
 		return;
 
@@ -164,7 +194,7 @@ multiload_set_max_floor (MultiloadPlugin *ma, guint graph_id, int val)
 int
 multiload_get_max_value(MultiloadPlugin *ma, guint graph_id)
 {
-	AutoScaler *scaler = multiload_get_scaler(ma, graph_id);
+	AutoScaler *scaler = multiload_collector_get_scaler(ma->graphs[graph_id]->collector);
 	if (scaler == NULL)
 		return -1;
 
@@ -244,7 +274,48 @@ multiload_set_order (MultiloadPlugin *ma, gint new_order[GRAPH_MAX])
 }
 
 void
-multiload_init()
+multiload_set_cgroup_scope (MultiloadPlugin *ma, const gchar *scope)
+{
+	gchar buf[sizeof(ma->cgroup_scope)];
+	guint i;
+
+	// scope can point to ma->cgroup_scope itself
+	g_strlcpy(buf, scope, sizeof(buf));
+	g_strlcpy(ma->cgroup_scope, buf, sizeof(ma->cgroup_scope));
+
+	multiload_cgroup_free(ma->cgroup);
+	ma->cgroup = NULL;
+
+	if (ma->cgroup_scope[0] != '\0') {
+		if (multiload_cgroup_is_supported())
+			ma->cgroup = multiload_cgroup_new(ma->cgroup_scope);
+		else
+			g_warning("[multiload] cgroup v2 hierarchy not found, ignoring scope '%s'", ma->cgroup_scope);
+	}
+
+	for (i = 0; i < GRAPH_MAX; i++)
+		ma->graphs[i]->collector->cgroup = ma->cgroup;
+
+	// counters of different scopes are unrelated, restart differential graphs
+	ma->graphs[GRAPH_CPULOAD]->collector->first_update = TRUE;
+	ma->graphs[GRAPH_DISKLOAD]->collector->first_update = TRUE;
+}
+
+void
+multiload_set_export (MultiloadPlugin *ma, gboolean enabled)
+{
+	ma->export_enabled = enabled;
+
+	if (enabled && ma->export == NULL) {
+		ma->export = multiload_export_new();
+	} else if (!enabled && ma->export != NULL) {
+		multiload_export_free(ma->export);
+		ma->export = NULL;
+	}
+}
+
+void
+multiload_init(gboolean headless)
 {
 	static gboolean initialized = FALSE;
 	if (initialized)
@@ -264,7 +335,9 @@ multiload_init()
 
 	multiload_config_init();
 
-	multiload_ui_print_notice();
+	// headless instances may write their output to stdout
+	if (!headless)
+		multiload_ui_print_notice();
 
 	g_debug("[multiload] Initialization complete");
 }
@@ -278,6 +351,9 @@ void multiload_defaults(MultiloadPlugin *ma)
 	ma->padding = DEFAULT_PADDING;
 	ma->spacing = DEFAULT_SPACING;
 	ma->size_format_iec = DEFAULT_SIZE_FORMAT_IEC;
+	ma->autoscaler_percentile = DEFAULT_AUTOSCALER_PERCENTILE;
+	ma->history_retention = DEFAULT_HISTORY_RETENTION;
+	ma->history_persist = DEFAULT_HISTORY_PERSIST;
 	strncpy(ma->color_scheme, DEFAULT_COLOR_SCHEME, sizeof(ma->color_scheme));
 	for ( i = 0; i < GRAPH_MAX; i++ ) {
 		conf = &ma->graph_config[i];
@@ -298,6 +374,16 @@ void multiload_defaults(MultiloadPlugin *ma)
 	}
 
 	((MemoryData*)ma->extra_data[GRAPH_MEMLOAD])->procps_compliant = TRUE;
+	((MemoryData*)ma->extra_data[GRAPH_MEMLOAD])->show_dirty = FALSE;
+	((MemoryData*)ma->extra_data[GRAPH_MEMLOAD])->show_hugepages = FALSE;
+	((NetData*)ma->extra_data[GRAPH_NETLOAD])->show_extended = FALSE;
+	((NetData*)ma->extra_data[GRAPH_NETLOAD])->show_per_iface = FALSE;
+	((NetData*)ma->extra_data[GRAPH_NETLOAD])->scale_link_speed = FALSE;
+	((SwapData*)ma->extra_data[GRAPH_SWAPLOAD])->show_activity = FALSE;
+	((SchedData*)ma->extra_data[GRAPH_SCHED])->show_softirqs = FALSE;
+
+	multiload_set_cgroup_scope(ma, "");
+	multiload_set_export(ma, DEFAULT_EXPORT_ENABLED);
 }
 
 void
@@ -309,6 +395,9 @@ multiload_sanitize(MultiloadPlugin *ma)
 	ma->padding = CLAMP(ma->padding, MIN_PADDING, MAX_PADDING);
 	ma->spacing = CLAMP(ma->spacing, MIN_SPACING, MAX_SPACING);
 	ma->orientation_policy = CLAMP(ma->orientation_policy, 0, MULTILOAD_ORIENTATION_N_VALUES);
+	ma->history_retention = CLAMP(ma->history_retention, MIN_HISTORY_RETENTION, MAX_HISTORY_RETENTION);
+	if (ma->autoscaler_percentile != 0)
+		ma->autoscaler_percentile = CLAMP(ma->autoscaler_percentile, MIN_AUTOSCALER_PERCENTILE, MAX_AUTOSCALER_PERCENTILE);
 
 	for ( i=0; i<GRAPH_MAX; i++ ) {
 		ma->graph_config[i].border_width = CLAMP(ma->graph_config[i].border_width, MIN_BORDER_WIDTH, MAX_BORDER_WIDTH);
@@ -336,35 +425,34 @@ multiload_set_update_cb (MultiloadPlugin *ma, guint graph_id, GraphUpdateFunc ca
 	ma->graphs[graph_id]->update_cb_user_data = user_data;
 }
 
+/* Headless instances have no widgets, graphs are sampled by the caller
+ * with load_graph_collect. GTK does not need to be initialized. */
 MultiloadPlugin*
-multiload_new()
+multiload_new_full(gboolean headless)
 {
 	guint i;
 	MultiloadPlugin *ma = g_slice_new0(MultiloadPlugin);
-	multiload_init();
-
-	ma->container = GTK_CONTAINER(gtk_event_box_new ());
-	gtk_widget_show (GTK_WIDGET(ma->container));
+	multiload_init(headless);
 
-	ma->extra_data[GRAPH_CPULOAD]		= (gpointer)g_new0(CpuData, 1);
-	ma->extra_data[GRAPH_MEMLOAD]		= (gpointer)g_new0(MemoryData, 1);
-	ma->extra_data[GRAPH_NETLOAD]		= (gpointer)g_new0(NetData, 1);
-	ma->extra_data[GRAPH_SWAPLOAD]		= (gpointer)g_new0(SwapData, 1);
-	ma->extra_data[GRAPH_LOADAVG]		= (gpointer)g_new0(LoadData, 1);
-	ma->extra_data[GRAPH_DISKLOAD]		= (gpointer)g_new0(DiskData, 1);
-	ma->extra_data[GRAPH_TEMPERATURE]	= (gpointer)g_new0(TemperatureData, 1);
-	ma->extra_data[GRAPH_BATTERY]		= (gpointer)g_new0(BatteryData, 1);
-	ma->extra_data[GRAPH_PARAMETRIC]	= (gpointer)g_new0(ParametricData, 1);
+	if (!headless) {
+		ma->container = GTK_CONTAINER(gtk_event_box_new ());
+		gtk_widget_show (GTK_WIDGET(ma->container));
+	}
 
 	for (i=0; i < GRAPH_MAX; i++) {
-		ma->graphs[i] = load_graph_new (ma, i);
-		if ( graph_types[i].init != NULL )
-			graph_types[i].init(ma->graphs[i], ma->extra_data[i]);
+		ma->graphs[i] = headless ? load_graph_new_headless (ma, i) : load_graph_new (ma, i);
+		ma->extra_data[i] = ma->graphs[i]->collector->data;
 	}
 
 	return ma;
 }
 
+MultiloadPlugin*
+multiload_new()
+{
+	return multiload_new_full(FALSE);
+}
+
 void
 multiload_free(MultiloadPlugin *ma)
 {
@@ -372,14 +460,21 @@ multiload_free(MultiloadPlugin *ma)
 
 	for (i = 0; i < GRAPH_MAX; i++) {
 		load_graph_stop (ma->graphs[i]);
-		gtk_widget_destroy (ma->graphs[i]->main_widget);
+		if (ma->graphs[i]->main_widget != NULL)
+			gtk_widget_destroy (ma->graphs[i]->main_widget);
 
 		load_graph_unalloc (ma->graphs[i]);
+		multiload_history_free (ma->graphs[i]->history);
+		multiload_collector_free (ma->graphs[i]->collector);
 		g_free (ma->graphs[i]);
-
-		g_free (ma->extra_data[i]);
 	}
 
+	if (ma->profile_timer != 0)
+		g_source_remove (ma->profile_timer);
+
+	multiload_cgroup_free (ma->cgroup);
+	multiload_export_free (ma->export);
+
 	g_free (ma);
 
 	g_debug("[multiload] Destroyed");
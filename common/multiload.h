@@ -28,27 +28,42 @@
 #include <gdk-pixbuf/gdk-pixbuf.h>
 #include <gtk/gtk.h>
 
+#include "cgroup.h"
+#include "collector.h"
 #include "gtk-compat.h"
+#include "export.h"
+#include "history.h"
+#include "multiload-config.h"
+#include "profile.h"
 
 
-#define MAX_COLORS 7
-
-enum GraphType {
-	GRAPH_CPULOAD,
-	GRAPH_MEMLOAD,
-	GRAPH_NETLOAD,
-	GRAPH_SWAPLOAD,
-	GRAPH_LOADAVG,
-	GRAPH_DISKLOAD,
-	GRAPH_TEMPERATURE,
-	GRAPH_BATTERY,
-	GRAPH_PARAMETRIC,
-
-	GRAPH_MAX
-};
+typedef struct _LoadGraph LoadGraph;
 
+/* One sample of a graph, at full precision. Values are fixed-point fractions
+ * of the scale in use when they were sampled. */
+typedef struct {
+	gfloat *scale;			// max value of each strip when sampled (0 if unknown)
+	gint value[];
+} LoadGraphColumn;
+
+/* Samples shown by a graph, column 0 is the most recent. Each series has its
+ * own row, so columns of a series are contiguous. Values are stored in 16 bits,
+ * shifted by LOAD_GRAPH_DATA_SHIFT so that values up to 4 times the scale of
+ * their column survive a later rescale (beyond that they are saturated), and
+ * converted to pixel heights only when the graph is drawn.
+ * All arrays live in the same allocation as this struct. */
+#define LOAD_GRAPH_DATA_SHIFT 2
 
-typedef struct _LoadGraph LoadGraph;
+typedef struct {
+	guint width;			// columns
+	guint n_values;			// rows of value and pixel: series of all strips
+	guint n_scales;			// rows of scale: one per strip
+	gfloat *scale;			// max value of each strip when sampled (0 if unknown)
+	guint *generation;		// scale generation of pixel heights of each column
+	guint16 *value;
+	guint16 *pixel;			// cached pixel heights
+	guint16 *pos[2];		// work area used to stack series
+} LoadGraphData;
 typedef void (*GraphUpdateFunc)	(LoadGraph *g, gpointer user_data);
 
 typedef struct _GraphConfig {
@@ -80,14 +95,24 @@ typedef struct _MultiloadPlugin {
 
 	LoadGraph *graphs[GRAPH_MAX];
 	GraphConfig graph_config[GRAPH_MAX];
-	gpointer extra_data[GRAPH_MAX]; // data depend on graph type
+	gpointer extra_data[GRAPH_MAX]; // data of each collector, depend on graph type
 
 	gint padding;
 	gint spacing;
 	gint orientation_policy;
 	gchar color_scheme[20];
 	gboolean size_format_iec;
+	gint autoscaler_percentile; // 0 for average mode
+	gint history_retention; // minutes
+	gboolean history_persist; // keep history in a file across restarts
+	gboolean export_enabled;
+	MultiloadExport *export; // NULL when export is disabled
 	gint graph_order[GRAPH_MAX];
+
+	gchar cgroup_scope[512];
+	MultiloadCgroup *cgroup; // NULL when monitoring the whole system
+
+	guint profile_timer; // periodic dump of profiling statistics, 0 if disabled
 } MultiloadPlugin;
 
 
@@ -95,27 +120,39 @@ struct _LoadGraph {
 	MultiloadPlugin *multiload;
 
 	guint id;
-	guint draw_width, draw_height;
+	guint draw_width, draw_height;	// logical pixels, one data column each
+	guint scale;					// device pixels per logical pixel of surface
+
+	LoadGraphData *data;
+	LoadGraphColumn *sample;	// last sample, before it is packed into data
+	MultiloadHistory *history; // samples kept when the widget is resized
 
-	gint **data;
-	guint *pos;
+	MultiloadCollector *collector; // data source, knows nothing about drawing
 
-	char output_str[4][20];
+	gfloat display_scale[MAX_STRIPS];
+	guint display_height;
+	guint scale_generation;
+
+	// graph area can be split in horizontal strips, each with its own data
+	guint n_strips;			// strips in use, 1 when graph is not split
+	guint strip_area;		// height the layout below was computed for
+	guint strip_height;
+	guint strip_y[MAX_STRIPS];
 
 	GtkWidget *main_widget;
 	GtkWidget *box, *disp;
 	cairo_surface_t *surface;
+	gboolean render_pending; // surface is older than data
 	int timer_index;
 
 	gboolean allocated;
-	gboolean tooltip_update;
-	gboolean filter_changed;
-	gboolean first_update;
 
 	GraphUpdateFunc update_cb;
 	gpointer update_cb_user_data;
 
 	GraphConfig *config;
+
+	MultiloadProfileStats profile;
 };
 
 typedef struct {
@@ -143,6 +180,8 @@ G_BEGIN_DECLS
 
 G_GNUC_INTERNAL void
 multiload_start(MultiloadPlugin *ma);
+G_GNUC_INTERNAL void
+multiload_start_profile_dump(MultiloadPlugin *ma);
 G_GNUC_INTERNAL GtkOrientation
 multiload_get_orientation(MultiloadPlugin *ma);
 G_GNUC_INTERNAL void
@@ -162,7 +201,11 @@ multiload_refresh_orientation (MultiloadPlugin *ma);
 G_GNUC_INTERNAL void
 multiload_set_order (MultiloadPlugin *ma, gint new_order[GRAPH_MAX]);
 G_GNUC_INTERNAL void
-multiload_init();
+multiload_set_cgroup_scope (MultiloadPlugin *ma, const gchar *scope);
+G_GNUC_INTERNAL void
+multiload_set_export (MultiloadPlugin *ma, gboolean enabled);
+G_GNUC_INTERNAL void
+multiload_init(gboolean headless);
 G_GNUC_INTERNAL void
 multiload_sanitize(MultiloadPlugin *ma);
 G_GNUC_INTERNAL void
@@ -171,6 +214,8 @@ G_GNUC_INTERNAL void
 multiload_defaults(MultiloadPlugin *ma);
 G_GNUC_INTERNAL MultiloadPlugin*
 multiload_new();
+G_GNUC_INTERNAL MultiloadPlugin*
+multiload_new_full(gboolean headless);
 G_GNUC_INTERNAL void
 multiload_free(MultiloadPlugin *ma);
 G_GNUC_INTERNAL int
@@ -35,6 +35,7 @@
 #include "multiload-config.h"
 #include "preferences.h"
 #include "util.h"
+#include "util-gtk.h"
 #include "ui.h"
 
 
@@ -44,7 +45,7 @@ static gboolean _orientation_warning_disable = FALSE;
 #define OB(name) (gtk_builder_get_object(builder, name))
 #define EMBED_GRAPH_INDEX(ob,i) g_object_set_data(G_OBJECT(ob), "graph-index", GUINT_TO_POINTER(i))
 #define EXTRACT_GRAPH_INDEX(ob) GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(ob), "graph-index"))
-#define DEFINE_OB_NAMES_FULL(p) static const gchar* (p##_names)[GRAPH_MAX] = { #p "_cpu", #p "_mem", #p "_net", #p "_swap", #p "_load", #p "_disk", #p "_temp", #p "_bat", #p "_parm" }
+#define DEFINE_OB_NAMES_FULL(p) static const gchar* (p##_names)[GRAPH_MAX] = { #p "_cpu", #p "_mem", #p "_net", #p "_swap", #p "_load", #p "_disk", #p "_temp", #p "_bat", #p "_parm", #p "_vm", #p "_sched" }
 
 
 DEFINE_OB_NAMES_FULL(cb_visible);
@@ -69,7 +70,9 @@ static const gchar* spin_ceil_names[GRAPH_MAX] = {
 	"sb_ceil_disk",
 	"sb_ceil_temp",
 	"",
-	"sb_ceil_parm"
+	"sb_ceil_parm",
+	"sb_ceil_vm",
+	"sb_ceil_sched"
 };
 
 static const gchar* cb_autoscaler_names[GRAPH_MAX] = {
@@ -81,7 +84,9 @@ static const gchar* cb_autoscaler_names[GRAPH_MAX] = {
 	"cb_autoscaler_disk",
 	"cb_autoscaler_temp",
 	"",
-	"cb_autoscaler_parm"
+	"cb_autoscaler_parm",
+	"cb_autoscaler_vm",
+	"cb_autoscaler_sched"
 };
 
 static const gchar* cb_source_auto_names[GRAPH_MAX] = {
@@ -93,6 +98,8 @@ static const gchar* cb_source_auto_names[GRAPH_MAX] = {
 	"cb_source_auto_disk",
 	"cb_source_auto_temp",
 	"",
+	"",
+	"",
 	""
 };
 
@@ -105,6 +112,8 @@ static const gchar* treeview_source_names[GRAPH_MAX] = {
 	"treeview_source_disk",
 	"treeview_source_temp",
 	"",
+	"",
+	"",
 	""
 };
 
@@ -117,6 +126,8 @@ static const gchar* cellrenderertoggle_source_names[GRAPH_MAX] = {
 	"cellrenderertoggle_source_disk",
 	"cellrenderertoggle_source_temp",
 	"",
+	"",
+	"",
 	""
 };
 
@@ -129,6 +140,8 @@ static const gchar* liststore_source_names[GRAPH_MAX] = {
 	"liststore_source_disk",
 	"liststore_source_temp",
 	"",
+	"",
+	"",
 	""
 };
 
@@ -145,6 +158,8 @@ static const gchar* color_button_names[GRAPH_MAX][MAX_COLORS] = {
 		"cb_color_mem1",
 		"cb_color_mem2",
 		"cb_color_mem3",
+		"cb_color_mem4",
+		"cb_color_mem5",
 		"cb_color_mem_border",
 		"cb_color_mem_bg1",
 		"cb_color_mem_bg2"
@@ -158,6 +173,8 @@ static const gchar* color_button_names[GRAPH_MAX][MAX_COLORS] = {
 		NULL
 	}, {
 		"cb_color_swap1",
+		"cb_color_swap2",
+		"cb_color_swap3",
 		"cb_color_swap_border",
 		"cb_color_swap_bg1",
 		"cb_color_swap_bg2",
@@ -198,6 +215,20 @@ static const gchar* color_button_names[GRAPH_MAX][MAX_COLORS] = {
 		"cb_color_parm_border",
 		"cb_color_parm_bg1",
 		"cb_color_parm_bg2"
+	}, {
+		"cb_color_vm1",
+		"cb_color_vm2",
+		"cb_color_vm_border",
+		"cb_color_vm_bg1",
+		"cb_color_vm_bg2",
+		NULL
+	}, {
+		"cb_color_sched1",
+		"cb_color_sched2",
+		"cb_color_sched_border",
+		"cb_color_sched_bg1",
+		"cb_color_sched_bg2",
+		NULL
 	}
 };
 
@@ -214,6 +245,11 @@ enum {
 	LS_COLORS_COLUMN_SEPARATOR	= 2
 };
 
+enum {
+	LS_CGROUP_COLUMN_LABEL		= 0,
+	LS_CGROUP_COLUMN_DATA		= 1
+};
+
 static guint
 multiload_preferences_get_graph_index (GtkBuildable *ob, const gchar **list)
 {
@@ -485,12 +521,68 @@ multiload_preferences_orientation_changed_cb (GtkComboBox *combo, MultiloadPlugi
 	multiload_refresh_orientation(ma);
 }
 
+static const gint autoscaler_percentiles[] = { 0, 95, 99 };
+
+static void
+multiload_preferences_autoscaler_mode_changed_cb (GtkComboBox *combo, MultiloadPlugin *ma)
+{
+	gint i = gtk_combo_box_get_active (combo);
+	if (i >= 0 && i < (gint)G_N_ELEMENTS(autoscaler_percentiles))
+		ma->autoscaler_percentile = autoscaler_percentiles[i];
+}
+
+static void
+multiload_preferences_history_retention_changed_cb (GtkSpinButton *spin, MultiloadPlugin *ma)
+{
+	guint i;
+
+	ma->history_retention = gtk_spin_button_get_value_as_int(spin);
+	for (i=0; i<GRAPH_MAX; i++) {
+		// stopped graphs get their history when started
+		if (ma->graphs[i]->timer_index != -1)
+			load_graph_setup_history(ma->graphs[i]);
+	}
+}
+
+static void
+multiload_preferences_history_persist_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	guint i;
+
+	ma->history_persist = gtk_toggle_button_get_active(toggle);
+	for (i=0; i<GRAPH_MAX; i++) {
+		if (ma->graphs[i]->timer_index != -1)
+			load_graph_setup_history(ma->graphs[i]);
+	}
+}
+
+static void
+multiload_preferences_export_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	multiload_set_export(ma, gtk_toggle_button_get_active(toggle));
+}
+
 static void
 multiload_preferences_iec_units_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
 {
 	ma->size_format_iec = gtk_toggle_button_get_active(toggle);
 }
 
+static void
+multiload_preferences_cgroup_scope_changed_cb (GtkComboBox *combo, MultiloadPlugin *ma)
+{
+	GtkTreeIter iter;
+	gchar *scope;
+
+	if (!gtk_combo_box_get_active_iter(combo, &iter))
+		return;
+
+	gtk_tree_model_get(gtk_combo_box_get_model(combo), &iter, LS_CGROUP_COLUMN_DATA, &scope, -1);
+	g_debug ("[preferences] set cgroup scope: '%s'", scope);
+	multiload_set_cgroup_scope(ma, scope);
+	g_free(scope);
+}
+
 static void
 multiload_preferences_tooltip_style_changed_cb (GtkComboBox *combo, MultiloadPlugin *ma)
 {
@@ -665,6 +757,55 @@ multiload_preferences_mem_slab_changed_cb (GtkComboBox *combo, MultiloadPlugin *
 	xd->procps_compliant = (gtk_combo_box_get_active (combo) == 1);
 }
 
+static void
+multiload_preferences_mem_dirty_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	MemoryData *xd = (MemoryData*)ma->extra_data[GRAPH_MEMLOAD];
+	xd->show_dirty = gtk_toggle_button_get_active(toggle);
+}
+
+static void
+multiload_preferences_mem_hugepages_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	MemoryData *xd = (MemoryData*)ma->extra_data[GRAPH_MEMLOAD];
+	xd->show_hugepages = gtk_toggle_button_get_active(toggle);
+}
+
+static void
+multiload_preferences_net_extended_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	NetData *xd = (NetData*)ma->extra_data[GRAPH_NETLOAD];
+	xd->show_extended = gtk_toggle_button_get_active(toggle);
+}
+
+static void
+multiload_preferences_net_per_iface_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	NetData *xd = (NetData*)ma->extra_data[GRAPH_NETLOAD];
+	xd->show_per_iface = gtk_toggle_button_get_active(toggle);
+}
+
+static void
+multiload_preferences_net_link_speed_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	NetData *xd = (NetData*)ma->extra_data[GRAPH_NETLOAD];
+	xd->scale_link_speed = gtk_toggle_button_get_active(toggle);
+}
+
+static void
+multiload_preferences_swap_mode_changed_cb (GtkComboBox *combo, MultiloadPlugin *ma)
+{
+	SwapData *xd = (SwapData*)ma->extra_data[GRAPH_SWAPLOAD];
+	xd->show_activity = (gtk_combo_box_get_active (combo) == 1);
+}
+
+static void
+multiload_preferences_sched_softirqs_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
+{
+	SchedData *xd = (SchedData*)ma->extra_data[GRAPH_SCHED];
+	xd->show_softirqs = gtk_toggle_button_get_active(toggle);
+}
+
 static void
 multiload_preferences_parm_command_changed_cb (GtkEntry *entry, MultiloadPlugin *ma)
 {
@@ -693,7 +834,7 @@ static void
 multiload_preferences_autoscaler_toggled_cb (GtkToggleButton *toggle, MultiloadPlugin *ma)
 {
 	guint i = multiload_preferences_get_graph_index(GTK_BUILDABLE(toggle), cb_autoscaler_names);
-	AutoScaler *scaler = multiload_get_scaler(ma, i);
+	AutoScaler *scaler = multiload_collector_get_scaler(ma->graphs[i]->collector);
 	if (scaler == NULL)
 		return;
 
@@ -713,7 +854,7 @@ static void
 multiload_preferences_ceil_changed_cb (GtkSpinButton *spin, MultiloadPlugin *ma)
 {
 	guint i = multiload_preferences_get_graph_index(GTK_BUILDABLE(spin), spin_ceil_names);
-	AutoScaler *scaler = multiload_get_scaler(ma, i);
+	AutoScaler *scaler = multiload_collector_get_scaler(ma->graphs[i]->collector);
 	if (scaler == NULL)
 		return;
 
@@ -809,7 +950,7 @@ multiload_preferences_source_toggled_cb (GtkCellRendererToggle *cell, gchar *pat
 	g_debug ("[preferences] set filter for graph #%d: %s\n", graph_index, ma->graph_config[graph_index].filter);
 
 	// trigger data refresh for graphs that require it
-	ma->graphs[graph_index]->filter_changed = TRUE;
+	ma->graphs[graph_index]->collector->filter_changed = TRUE;
 }
 
 static void
@@ -821,7 +962,7 @@ multiload_preferences_source_auto_toggled_cb (GtkToggleButton *toggle, Multiload
 	ma->graph_config[i].filter_enable = !b;
 
 	// trigger data refresh for graphs that require it
-	ma->graphs[i]->filter_changed = TRUE;
+	ma->graphs[i]->collector->filter_changed = TRUE;
 
 	multiload_preferences_update_dynamic_widgets(ma);
 }
@@ -861,10 +1002,14 @@ multiload_preferences_dev_colorscheme_generate_clicked_cb (GtkToolButton *btn, M
 	_CPRINT(ma->graph_config[GRAPH_MEMLOAD].colors[2], buf);
 	printf("\t\t\t\t%s,\t\t// Cached\n", buf);
 	_CPRINT(ma->graph_config[GRAPH_MEMLOAD].colors[3], buf);
-	printf("\t\t\t\t%s,\t\t// Border\n", buf);
+	printf("\t\t\t\t%s,\t\t// Dirty/Writeback\n", buf);
 	_CPRINT(ma->graph_config[GRAPH_MEMLOAD].colors[4], buf);
-	printf("\t\t\t\t%s,\t\t// Background (top)\n", buf);
+	printf("\t\t\t\t%s,\t\t// Huge pages\n", buf);
 	_CPRINT(ma->graph_config[GRAPH_MEMLOAD].colors[5], buf);
+	printf("\t\t\t\t%s,\t\t// Border\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_MEMLOAD].colors[6], buf);
+	printf("\t\t\t\t%s,\t\t// Background (top)\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_MEMLOAD].colors[7], buf);
 	printf("\t\t\t\t%s\t\t\t// Background (bottom)\n", buf);
 
 	printf("\t\t\t}, { // NET\n");
@@ -885,10 +1030,14 @@ multiload_preferences_dev_colorscheme_generate_clicked_cb (GtkToolButton *btn, M
 	_CPRINT(ma->graph_config[GRAPH_SWAPLOAD].colors[0], buf);
 	printf("\t\t\t\t%s,\t\t// Used\n", buf);
 	_CPRINT(ma->graph_config[GRAPH_SWAPLOAD].colors[1], buf);
-	printf("\t\t\t\t%s,\t\t// Border\n", buf);
+	printf("\t\t\t\t%s,\t\t// Swap in\n", buf);
 	_CPRINT(ma->graph_config[GRAPH_SWAPLOAD].colors[2], buf);
-	printf("\t\t\t\t%s,\t\t// Background (top)\n", buf);
+	printf("\t\t\t\t%s,\t\t// Swap out\n", buf);
 	_CPRINT(ma->graph_config[GRAPH_SWAPLOAD].colors[3], buf);
+	printf("\t\t\t\t%s,\t\t// Border\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_SWAPLOAD].colors[4], buf);
+	printf("\t\t\t\t%s,\t\t// Background (top)\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_SWAPLOAD].colors[5], buf);
 	printf("\t\t\t\t%s\t\t\t// Background (bottom)\n", buf);
 
 	printf("\t\t\t}, { // LOAD\n");
@@ -955,6 +1104,30 @@ multiload_preferences_dev_colorscheme_generate_clicked_cb (GtkToolButton *btn, M
 	_CPRINT(ma->graph_config[GRAPH_PARAMETRIC].colors[6], buf);
 	printf("\t\t\t\t%s\t\t\t// Background (bottom)\n", buf);
 
+	printf("\t\t\t}, { // VM\n");
+	_CPRINT(ma->graph_config[GRAPH_VMSTAT].colors[0], buf);
+	printf("\t\t\t\t%s,\t\t// Major faults\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_VMSTAT].colors[1], buf);
+	printf("\t\t\t\t%s,\t\t// Direct reclaim\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_VMSTAT].colors[2], buf);
+	printf("\t\t\t\t%s,\t\t// Border\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_VMSTAT].colors[3], buf);
+	printf("\t\t\t\t%s,\t\t// Background (top)\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_VMSTAT].colors[4], buf);
+	printf("\t\t\t\t%s\t\t\t// Background (bottom)\n", buf);
+
+	printf("\t\t\t}, { // SCHED\n");
+	_CPRINT(ma->graph_config[GRAPH_SCHED].colors[0], buf);
+	printf("\t\t\t\t%s,\t\t// Context switches\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_SCHED].colors[1], buf);
+	printf("\t\t\t\t%s,\t\t// Interrupts\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_SCHED].colors[2], buf);
+	printf("\t\t\t\t%s,\t\t// Border\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_SCHED].colors[3], buf);
+	printf("\t\t\t\t%s,\t\t// Background (top)\n", buf);
+	_CPRINT(ma->graph_config[GRAPH_SCHED].colors[4], buf);
+	printf("\t\t\t\t%s\t\t\t// Background (bottom)\n", buf);
+
 	printf("\t\t\t}\n");
 	printf("\t\t}\n");
 	printf("\t},\n");
@@ -1356,9 +1529,23 @@ multiload_preferences_connect_signals (MultiloadPlugin *ma)
 	g_signal_connect(G_OBJECT(OB("hscale_spacing")), "value-changed", G_CALLBACK(multiload_preferences_spacing_or_padding_changed_cb), ma);
 	g_signal_connect(G_OBJECT(OB("hscale_padding")), "value-changed", G_CALLBACK(multiload_preferences_spacing_or_padding_changed_cb), ma);
 	g_signal_connect(G_OBJECT(OB("combo_orientation")), "changed", G_CALLBACK(multiload_preferences_orientation_changed_cb), ma);
+	g_signal_connect(G_OBJECT(OB("combo_cgroup_scope")), "changed", G_CALLBACK(multiload_preferences_cgroup_scope_changed_cb), ma);
+	g_signal_connect(G_OBJECT(OB("combo_autoscaler_mode")), "changed", G_CALLBACK(multiload_preferences_autoscaler_mode_changed_cb), ma);
+	g_signal_connect(G_OBJECT(OB("sb_history_retention")), "value-changed", G_CALLBACK(multiload_preferences_history_retention_changed_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_history_persist")), "toggled", G_CALLBACK(multiload_preferences_history_persist_toggled_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_export_enabled")), "toggled", G_CALLBACK(multiload_preferences_export_toggled_cb), ma);
 
 	// Memory graph
 	g_signal_connect(G_OBJECT(OB("combo_mem_slab")), "changed", G_CALLBACK(multiload_preferences_mem_slab_changed_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_mem_dirty")), "toggled", G_CALLBACK(multiload_preferences_mem_dirty_toggled_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_mem_hugepages")), "toggled", G_CALLBACK(multiload_preferences_mem_hugepages_toggled_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_net_extended")), "toggled", G_CALLBACK(multiload_preferences_net_extended_toggled_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_net_per_iface")), "toggled", G_CALLBACK(multiload_preferences_net_per_iface_toggled_cb), ma);
+	g_signal_connect(G_OBJECT(OB("cb_net_link_speed")), "toggled", G_CALLBACK(multiload_preferences_net_link_speed_toggled_cb), ma);
+	g_signal_connect(G_OBJECT(OB("combo_swap_mode")), "changed", G_CALLBACK(multiload_preferences_swap_mode_changed_cb), ma);
+
+	// Scheduler graph
+	g_signal_connect(G_OBJECT(OB("cb_sched_softirqs")), "toggled", G_CALLBACK(multiload_preferences_sched_softirqs_toggled_cb), ma);
 
 	// Parametric graph
 	g_signal_connect(G_OBJECT(OB("entry_parm_command")), "changed", G_CALLBACK(multiload_preferences_parm_command_changed_cb), ma);
@@ -1494,7 +1681,7 @@ multiload_preferences_fill_dialog (GtkWidget *dialog, MultiloadPlugin *ma)
 		if (cb_source_auto_names[i][0] != '\0') {
 			gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB(cb_source_auto_names[i])), !conf->filter_enable);
 
-			MultiloadFilter *filter = graph_types[i].get_filter(ma->graphs[i], ma->extra_data[i]);
+			MultiloadFilter *filter = graph_types[i].get_filter(ma->graphs[i]->collector, ma->extra_data[i]);
 			for (j=0; j<multiload_filter_get_length(filter); j++) {
 				gtk_list_store_insert_with_values (GTK_LIST_STORE(OB(liststore_source_names[i])), NULL, -1,
 					LS_SOURCE_COLUMN_SELECTED,	multiload_filter_get_element_selected	(filter, j),
@@ -1514,8 +1701,62 @@ multiload_preferences_fill_dialog (GtkWidget *dialog, MultiloadPlugin *ma)
 	gtk_combo_box_set_active (GTK_COMBO_BOX(OB("combo_orientation")), ma->orientation_policy);
 	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_iec_units")), ma->size_format_iec);
 
+	// autoscaler mode (custom percentiles from settings are shown as the closest one)
+	for (i=G_N_ELEMENTS(autoscaler_percentiles)-1; i>0; i--) {
+		if (ma->autoscaler_percentile >= autoscaler_percentiles[i])
+			break;
+	}
+	gtk_combo_box_set_active (GTK_COMBO_BOX(OB("combo_autoscaler_mode")), (ma->autoscaler_percentile == 0) ? 0 : MAX(i, 1));
+
+	gtk_spin_button_set_value(GTK_SPIN_BUTTON(OB("sb_history_retention")), ma->history_retention*1.00);
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_history_persist")), ma->history_persist);
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_export_enabled")), ma->export_enabled);
+
+	// cgroup scope (first entry is whole system)
+	GtkListStore *ls_cgroup = GTK_LIST_STORE(OB("liststore_cgroup_scope"));
+	MultiloadFilter *cgroup_filter = multiload_cgroup_get_filter(ma->cgroup_scope);
+	gint cgroup_active = 0;
+	gtk_list_store_insert_with_values( ls_cgroup, NULL, -1,
+		LS_CGROUP_COLUMN_LABEL,		_("Whole system"),
+		LS_CGROUP_COLUMN_DATA,		"",
+	-1 );
+	for (i=0; i<multiload_filter_get_length(cgroup_filter); i++) {
+		gchar *data = multiload_filter_get_element_data(cgroup_filter, i);
+		gchar *label;
+
+		if (multiload_filter_get_element_absent(cgroup_filter, i))
+			label = g_strdup_printf(_("%s (not found)"), data);
+		else
+			label = g_strdup(data);
+
+		gtk_list_store_insert_with_values( ls_cgroup, NULL, -1,
+			LS_CGROUP_COLUMN_LABEL,		label,
+			LS_CGROUP_COLUMN_DATA,		data,
+		-1 );
+		g_free(label);
+
+		if (strcmp(data, ma->cgroup_scope) == 0)
+			cgroup_active = i+1;
+	}
+	multiload_filter_free(cgroup_filter);
+	gtk_combo_box_set_active (GTK_COMBO_BOX(OB("combo_cgroup_scope")), cgroup_active);
+	gtk_widget_set_sensitive(GTK_WIDGET(OB("combo_cgroup_scope")), multiload_cgroup_is_supported());
+
 	// Memory
 	gtk_combo_box_set_active (GTK_COMBO_BOX(OB("combo_mem_slab")), ((MemoryData*)ma->extra_data[GRAPH_MEMLOAD])->procps_compliant?1:0);
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_mem_dirty")), ((MemoryData*)ma->extra_data[GRAPH_MEMLOAD])->show_dirty);
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_mem_hugepages")), ((MemoryData*)ma->extra_data[GRAPH_MEMLOAD])->show_hugepages);
+
+	// Network
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_net_extended")), ((NetData*)ma->extra_data[GRAPH_NETLOAD])->show_extended);
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_net_per_iface")), ((NetData*)ma->extra_data[GRAPH_NETLOAD])->show_per_iface);
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_net_link_speed")), ((NetData*)ma->extra_data[GRAPH_NETLOAD])->scale_link_speed);
+
+	// Swap
+	gtk_combo_box_set_active (GTK_COMBO_BOX(OB("combo_swap_mode")), ((SwapData*)ma->extra_data[GRAPH_SWAPLOAD])->show_activity?1:0);
+
+	// Scheduler
+	gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(OB("cb_sched_softirqs")), ((SchedData*)ma->extra_data[GRAPH_SCHED])->show_softirqs);
 
 	// Parametric
 	gtk_entry_set_text(GTK_ENTRY(OB("entry_parm_command")), ((ParametricData*)ma->extra_data[GRAPH_PARAMETRIC])->command);
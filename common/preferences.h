@@ -46,13 +46,6 @@ enum MultiloadDblClickPolicy {
 	DBLCLICK_POLICY_N_VALUES			= 2
 };
 
-enum MultiloadTooltipStyle {
-	MULTILOAD_TOOLTIP_STYLE_SIMPLE		= 0,
-	MULTILOAD_TOOLTIP_STYLE_DETAILED	= 1,
-
-	MULTILOAD_TOOLTIP_STYLE_N_VALUES	= 1
-};
-
 enum MultiloadLimits {
 	MIN_SIZE							= 10,
 	MAX_SIZE							= 400,
@@ -67,7 +60,13 @@ enum MultiloadLimits {
 	MAX_SPACING							= 40,
 
 	MIN_BORDER_WIDTH					= 0,
-	MAX_BORDER_WIDTH					= 16
+	MAX_BORDER_WIDTH					= 16,
+
+	MIN_AUTOSCALER_PERCENTILE			= 50,
+	MAX_AUTOSCALER_PERCENTILE			= 100,
+
+	MIN_HISTORY_RETENTION				= 0,
+	MAX_HISTORY_RETENTION				= 1440
 };
 
 enum MultiloadDefaults {
@@ -80,7 +79,11 @@ enum MultiloadDefaults {
 	DEFAULT_DBLCLICK_POLICY				= DBLCLICK_POLICY_DONOTHING,
 	DEFAULT_TOOLTIP_STYLE				= MULTILOAD_TOOLTIP_STYLE_SIMPLE,
 	DEFAULT_BACKGROUND_DIRECTION		= MULTILOAD_GRADIENT_LINEAR_N_TO_S,
-	DEFAULT_SIZE_FORMAT_IEC				= TRUE
+	DEFAULT_SIZE_FORMAT_IEC				= TRUE,
+	DEFAULT_AUTOSCALER_PERCENTILE		= 0,
+	DEFAULT_HISTORY_RETENTION			= 10,
+	DEFAULT_HISTORY_PERSIST				= FALSE,
+	DEFAULT_EXPORT_ENABLED				= FALSE
 };
 
 enum MultiloadSettingsType {
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "info-file.h"
+#include "proc-stat.h"
+
+
+#define PATH_STAT "/proc/stat"
+
+/* /proc/stat is system wide, so one cached copy serves every graph (and every
+ * plugin instance in the same process). The "intr" line alone holds one
+ * counter per IRQ number, so the buffer grows as needed. */
+static struct {
+	gint fd;
+	gchar *buf;
+	gsize size;
+	MultiloadProcStat last;
+} cache = { -1, NULL, 0, { 0 } };
+
+
+static gssize
+multiload_proc_stat_read_file ()
+{
+	gssize n;
+
+	if (cache.fd < 0) {
+		cache.fd = info_file_open(PATH_STAT, O_RDONLY | O_CLOEXEC);
+		if (cache.fd < 0) {
+			g_warning("[proc-stat] Unable to open '%s': %s", PATH_STAT, g_strerror(errno));
+			return -1;
+		}
+	}
+
+	if (cache.buf == NULL) {
+		cache.size = 8192;
+		cache.buf = g_malloc(cache.size);
+	}
+
+	for (;;) {
+		n = pread(cache.fd, cache.buf, cache.size-1, 0);
+		if (n < 0) {
+			g_debug("[proc-stat] Unable to read '%s': %s", PATH_STAT, g_strerror(errno));
+			close(cache.fd);
+			cache.fd = -1;
+			return -1;
+		}
+		if ((gsize)n < cache.size-1)
+			break;
+
+		// file did not fit, read it again with a larger buffer
+		cache.size *= 2;
+		cache.buf = g_realloc(cache.buf, cache.size);
+		g_debug("[proc-stat] Buffer enlarged to %"G_GSIZE_FORMAT" bytes", cache.size);
+	}
+
+	cache.buf[n] = '\0';
+	return n;
+}
+
+/* Lines are identified by their first character, then the full key is checked.
+ * For "intr" and "softirq" only the leading total is parsed. */
+static void
+multiload_proc_stat_parse (MultiloadProcStat *stat)
+{
+	gchar *line, *next;
+
+	for (line = cache.buf; line != NULL && *line != '\0'; line = next) {
+		next = strchr(line, '\n');
+		if (next != NULL)
+			next++;
+
+		switch (line[0]) {
+			case 'c':
+				if (strncmp(line, "cpu ", 4) == 0)
+					sscanf(line+4, "%"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT" %"G_GUINT64_FORMAT,
+						&stat->cpu[PROC_STAT_CPU_USER], &stat->cpu[PROC_STAT_CPU_NICE], &stat->cpu[PROC_STAT_CPU_SYSTEM], &stat->cpu[PROC_STAT_CPU_IDLE],
+						&stat->cpu[PROC_STAT_CPU_IOWAIT], &stat->cpu[PROC_STAT_CPU_IRQ], &stat->cpu[PROC_STAT_CPU_SOFTIRQ]);
+				else if (strncmp(line, "ctxt ", 5) == 0)
+					stat->ctxt = g_ascii_strtoull(line+5, NULL, 10);
+				break;
+			case 'i':
+				if (strncmp(line, "intr ", 5) == 0)
+					stat->intr = g_ascii_strtoull(line+5, NULL, 10);
+				break;
+			case 's':
+				if (strncmp(line, "softirq ", 8) == 0)
+					stat->softirq = g_ascii_strtoull(line+8, NULL, 10);
+				break;
+			case 'p':
+				if (strncmp(line, "procs_running ", 14) == 0)
+					stat->procs_running = g_ascii_strtoull(line+14, NULL, 10);
+				else if (strncmp(line, "procs_blocked ", 14) == 0)
+					stat->procs_blocked = g_ascii_strtoull(line+14, NULL, 10);
+				break;
+		}
+	}
+}
+
+/* Forgets the last read, so that next call reads the file again whatever its
+ * age. Used when contents change faster than time goes (fixture replay). */
+void
+multiload_proc_stat_invalidate ()
+{
+	cache.last.time = 0;
+}
+
+/* Fills stat with the contents of /proc/stat. If the last read is not older
+ * than max_age microseconds, it is reused instead of reading the file again. */
+gboolean
+multiload_proc_stat_read (MultiloadProcStat *stat, gint64 max_age)
+{
+	gint64 now = g_get_monotonic_time();
+
+	if (cache.last.time > 0 && now - cache.last.time <= max_age) {
+		memcpy(stat, &cache.last, sizeof(MultiloadProcStat));
+		return TRUE;
+	}
+
+	if (multiload_proc_stat_read_file() < 0)
+		return FALSE;
+
+	memset(&cache.last, 0, sizeof(cache.last));
+	multiload_proc_stat_parse(&cache.last);
+	cache.last.time = now;
+
+	memcpy(stat, &cache.last, sizeof(MultiloadProcStat));
+	return TRUE;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __MULTILOAD_PROC_STAT_H__
+#define __MULTILOAD_PROC_STAT_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+enum {
+	PROC_STAT_CPU_USER,
+	PROC_STAT_CPU_NICE,
+	PROC_STAT_CPU_SYSTEM,
+	PROC_STAT_CPU_IDLE,
+	PROC_STAT_CPU_IOWAIT,
+	PROC_STAT_CPU_IRQ,
+	PROC_STAT_CPU_SOFTIRQ,
+
+	PROC_STAT_CPU_MAX
+};
+
+// Contents of /proc/stat we are interested in (per-CPU lines are skipped)
+typedef struct {
+	gint64 time;		// monotonic time of the read, in microseconds
+	guint64 cpu[PROC_STAT_CPU_MAX];
+	guint64 ctxt;
+	guint64 intr;		// total of all interrupts
+	guint64 softirq;	// total of all softirqs
+	guint procs_running;
+	guint procs_blocked;
+} MultiloadProcStat;
+
+
+G_GNUC_INTERNAL gboolean
+multiload_proc_stat_read (MultiloadProcStat *stat, gint64 max_age);
+G_GNUC_INTERNAL void
+multiload_proc_stat_invalidate ();
+
+G_END_DECLS
+
+#endif /* __MULTILOAD_PROC_STAT_H__ */
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "profile.h"
+
+
+#define PATH_SELF_IO "/proc/self/io"
+#define OVERLAY_FONT_SIZE 8
+
+static gint opt_dump_interval = 0;
+static gboolean opt_overlay = FALSE;
+static gboolean initialized = FALSE;
+
+static gint io_fd = -1;
+static gboolean io_available = TRUE;
+
+GOptionEntry multiload_profile_entries[] = {
+	{ "profile",			0, 0, G_OPTION_ARG_INT,		&opt_dump_interval,	"Print timings of each graph to standard error every N seconds", "N" },
+	{ "profile-overlay",	0, 0, G_OPTION_ARG_NONE,	&opt_overlay,		"Draw timings of each graph over the graph itself", NULL },
+	{ NULL }
+};
+
+
+/* Command line options win over environment */
+static void
+multiload_profile_init ()
+{
+	const gchar *env;
+
+	if (G_LIKELY(initialized))
+		return;
+	initialized = TRUE;
+
+	env = g_getenv("MULTILOAD_PROFILE");
+	if (opt_dump_interval <= 0 && env != NULL)
+		opt_dump_interval = atoi(env);
+	opt_dump_interval = MAX(opt_dump_interval, 0);
+
+	env = g_getenv("MULTILOAD_PROFILE_OVERLAY");
+	if (!opt_overlay && env != NULL && strcmp(env, "0") != 0)
+		opt_overlay = TRUE;
+
+	if (opt_dump_interval > 0 || opt_overlay)
+		g_debug("[profile] Enabled (dump interval: %d s, overlay: %s)", opt_dump_interval, opt_overlay ? "yes" : "no");
+}
+
+gboolean
+multiload_profile_enabled ()
+{
+	multiload_profile_init();
+	return opt_dump_interval > 0 || opt_overlay;
+}
+
+gboolean
+multiload_profile_overlay_enabled ()
+{
+	multiload_profile_init();
+	return opt_overlay;
+}
+
+guint
+multiload_profile_get_dump_interval ()
+{
+	multiload_profile_init();
+	return opt_dump_interval;
+}
+
+static guint64
+multiload_profile_now ()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (guint64)ts.tv_sec * G_GUINT64_CONSTANT(1000000000) + ts.tv_nsec;
+}
+
+/* Reads process I/O counters. Returns length of data read, that is accounted
+ * in the counters of the next read. */
+static gssize
+multiload_profile_read_io (guint64 *syscalls, guint64 *bytes_read)
+{
+	gchar buf[256];
+	gchar *line, *next;
+	gssize n;
+
+	*syscalls = 0;
+	*bytes_read = 0;
+
+	if (!io_available)
+		return 0;
+
+	if (io_fd < 0) {
+		io_fd = open(PATH_SELF_IO, O_RDONLY | O_CLOEXEC);
+		if (io_fd < 0) {
+			g_debug("[profile] Unable to open '%s' (%s), I/O will not be counted", PATH_SELF_IO, g_strerror(errno));
+			io_available = FALSE;
+			return 0;
+		}
+	}
+
+	n = pread(io_fd, buf, sizeof(buf)-1, 0);
+	if (n <= 0) {
+		close(io_fd);
+		io_fd = -1;
+		io_available = FALSE;
+		return 0;
+	}
+	buf[n] = '\0';
+
+	for (line = buf; line != NULL && *line != '\0'; line = next) {
+		next = strchr(line, '\n');
+		if (next != NULL)
+			next++;
+
+		if (strncmp(line, "rchar: ", 7) == 0)
+			*bytes_read = g_ascii_strtoull(line+7, NULL, 10);
+		else if (strncmp(line, "syscr: ", 7) == 0 || strncmp(line, "syscw: ", 7) == 0)
+			*syscalls += g_ascii_strtoull(line+7, NULL, 10);
+	}
+
+	return n;
+}
+
+void
+multiload_profile_begin (MultiloadProfileStats *stats, MultiloadProfileStage stage)
+{
+	if (!multiload_profile_enabled())
+		return;
+
+	if (stage == MULTILOAD_PROFILE_SAMPLE) {
+		// this read shows up in the counters of the next one
+		gssize n = multiload_profile_read_io(&stats->begin_syscalls, &stats->begin_bytes_read);
+		if (n > 0) {
+			stats->begin_syscalls++;
+			stats->begin_bytes_read += n;
+		}
+	}
+
+	stats->begin_ns = multiload_profile_now();
+}
+
+void
+multiload_profile_end (MultiloadProfileStats *stats, MultiloadProfileStage stage)
+{
+	guint64 syscalls, bytes_read;
+
+	if (!multiload_profile_enabled() || stats->begin_ns == 0)
+		return;
+
+	stats->last_ns[stage] = multiload_profile_now() - stats->begin_ns;
+	stats->total_ns[stage] += stats->last_ns[stage];
+	stats->begin_ns = 0;
+
+	if (stage == MULTILOAD_PROFILE_SAMPLE) {
+		multiload_profile_read_io(&syscalls, &bytes_read);
+		stats->last_syscalls = syscalls >= stats->begin_syscalls ? syscalls - stats->begin_syscalls : 0;
+		stats->last_bytes_read = bytes_read >= stats->begin_bytes_read ? bytes_read - stats->begin_bytes_read : 0;
+		stats->total_syscalls += stats->last_syscalls;
+		stats->total_bytes_read += stats->last_bytes_read;
+		stats->ticks++;
+	}
+}
+
+/* Averages per tick since start */
+void
+multiload_profile_format (MultiloadProfileStats *stats, gchar *buf, gsize len)
+{
+	guint64 ticks = MAX(stats->ticks, 1);
+
+	g_snprintf(buf, len, "ticks=%"G_GUINT64_FORMAT" sample_us=%.1f draw_us=%.1f tooltip_us=%.1f syscalls=%.1f bytes_read=%.0f allocs=%"G_GUINT64_FORMAT,
+			stats->ticks,
+			stats->total_ns[MULTILOAD_PROFILE_SAMPLE] / 1000.0 / ticks,
+			stats->total_ns[MULTILOAD_PROFILE_DRAW] / 1000.0 / ticks,
+			stats->total_ns[MULTILOAD_PROFILE_TOOLTIP] / 1000.0 / ticks,
+			(gdouble)stats->total_syscalls / ticks,
+			(gdouble)stats->total_bytes_read / ticks,
+			stats->allocs);
+}
+
+/* Last tick, in the top left corner of the graph area. Lines that do not fit
+ * are not drawn. */
+void
+multiload_profile_draw_overlay (MultiloadProfileStats *stats, cairo_t *cr, guint x, guint y, guint width, guint height)
+{
+	cairo_text_extents_t extents;
+	gchar lines[2][48];
+	guint i;
+
+	g_snprintf(lines[0], sizeof(lines[0]), "%.0f/%.0f/%.0fus",
+			stats->last_ns[MULTILOAD_PROFILE_SAMPLE] / 1000.0,
+			stats->last_ns[MULTILOAD_PROFILE_DRAW] / 1000.0,
+			stats->last_ns[MULTILOAD_PROFILE_TOOLTIP] / 1000.0);
+	g_snprintf(lines[1], sizeof(lines[1]), "%"G_GUINT64_FORMAT"sc %"G_GUINT64_FORMAT"B",
+			stats->last_syscalls, stats->last_bytes_read);
+
+	cairo_save(cr);
+	cairo_rectangle(cr, x, y, width, height);
+	cairo_clip(cr);
+	cairo_select_font_face(cr, "monospace", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+	cairo_set_font_size(cr, OVERLAY_FONT_SIZE);
+
+	for (i = 0; i < G_N_ELEMENTS(lines); i++) {
+		guint line_y = y + (i+1) * (OVERLAY_FONT_SIZE + 1);
+		if (line_y > y + height)
+			break;
+
+		cairo_text_extents(cr, lines[i], &extents);
+		cairo_set_source_rgba(cr, 0, 0, 0, 0.6);
+		cairo_rectangle(cr, x, line_y - OVERLAY_FONT_SIZE, extents.x_advance + 2, OVERLAY_FONT_SIZE + 1);
+		cairo_fill(cr);
+
+		cairo_set_source_rgb(cr, 1, 1, 1);
+		cairo_move_to(cr, x + 1, line_y - 1);
+		cairo_show_text(cr, lines[i]);
+	}
+
+	cairo_restore(cr);
+}
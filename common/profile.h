@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+#ifndef __MULTILOAD_PROFILE_H__
+#define __MULTILOAD_PROFILE_H__
+
+#include <glib.h>
+#include <cairo.h>
+
+
+G_BEGIN_DECLS
+
+/* Self-profiling of graphs. It is off by default, and enabled with command
+ * line options (see multiload_profile_entries) or environment variables:
+ *   MULTILOAD_PROFILE=N         print statistics to stderr every N seconds
+ *   MULTILOAD_PROFILE_OVERLAY=1 draw statistics of last tick on graphs
+ *
+ * Each graph owns its statistics and they are only touched from the thread
+ * running the graph timers, so no locking is involved. System calls and
+ * bytes read come from /proc/self/io, they count the whole process while
+ * the collector runs. */
+
+typedef enum {
+	MULTILOAD_PROFILE_SAMPLE,
+	MULTILOAD_PROFILE_DRAW,
+	MULTILOAD_PROFILE_TOOLTIP,
+
+	MULTILOAD_PROFILE_STAGES
+} MultiloadProfileStage;
+
+typedef struct {
+	guint64 ticks;
+
+	// last tick
+	guint64 last_ns[MULTILOAD_PROFILE_STAGES];
+	guint64 last_syscalls;	// read and write system calls
+	guint64 last_bytes_read;
+
+	// sums since start
+	guint64 total_ns[MULTILOAD_PROFILE_STAGES];
+	guint64 total_syscalls;
+	guint64 total_bytes_read;
+
+	guint64 allocs;			// reallocations of graph buffers, expected to stop after startup
+
+	// state of the stage being measured
+	guint64 begin_ns;
+	guint64 begin_syscalls;
+	guint64 begin_bytes_read;
+} MultiloadProfileStats;
+
+
+extern GOptionEntry multiload_profile_entries[];
+
+G_GNUC_INTERNAL gboolean
+multiload_profile_enabled ();
+G_GNUC_INTERNAL gboolean
+multiload_profile_overlay_enabled ();
+G_GNUC_INTERNAL guint
+multiload_profile_get_dump_interval ();
+G_GNUC_INTERNAL void
+multiload_profile_begin (MultiloadProfileStats *stats, MultiloadProfileStage stage);
+G_GNUC_INTERNAL void
+multiload_profile_end (MultiloadProfileStats *stats, MultiloadProfileStage stage);
+G_GNUC_INTERNAL void
+multiload_profile_format (MultiloadProfileStats *stats, gchar *buf, gsize len);
+G_GNUC_INTERNAL void
+multiload_profile_draw_overlay (MultiloadProfileStats *stats, cairo_t *cr, guint x, guint y, guint width, guint height);
+
+G_END_DECLS
+
+#endif /* __MULTILOAD_PROFILE_H__ */
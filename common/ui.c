@@ -70,6 +70,15 @@ multiload_ui_read (MultiloadPlugin *ma)
 		multiload_ps_settings_get_int		(settings, "pref-dialog-width",		&ma->pref_dialog_width);
 		multiload_ps_settings_get_int		(settings, "pref-dialog-height",	&ma->pref_dialog_height);
 		multiload_ps_settings_get_boolean	(settings, "size-format-iec",		&ma->size_format_iec);
+		multiload_ps_settings_get_int		(settings, "autoscaler-percentile",	&ma->autoscaler_percentile);
+		multiload_ps_settings_get_int		(settings, "history-retention",		&ma->history_retention);
+		multiload_ps_settings_get_boolean	(settings, "history-persist",		&ma->history_persist);
+		multiload_ps_settings_get_boolean	(settings, "export-enabled",		&ma->export_enabled);
+		multiload_set_export(ma, ma->export_enabled);
+
+		/* cgroup scope */
+		multiload_ps_settings_get_string	(settings, "cgroup-scope",		ma->cgroup_scope, sizeof(ma->cgroup_scope));
+		multiload_set_cgroup_scope(ma, ma->cgroup_scope);
 
 		/* Color scheme */
 		multiload_ps_settings_get_string	(settings, "color-scheme",		ma->color_scheme, sizeof(ma->color_scheme));
@@ -88,6 +97,36 @@ multiload_ui_read (MultiloadPlugin *ma)
 		key = g_strdup_printf("graph-%s-procps-compliant", graph_types[GRAPH_MEMLOAD].name);
 		multiload_ps_settings_get_boolean (settings, key, &xd_mem->procps_compliant);
 		g_free (key);
+		key = g_strdup_printf("graph-%s-show-dirty", graph_types[GRAPH_MEMLOAD].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_mem->show_dirty);
+		g_free (key);
+		key = g_strdup_printf("graph-%s-show-hugepages", graph_types[GRAPH_MEMLOAD].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_mem->show_hugepages);
+		g_free (key);
+
+		/* Network graph */
+		NetData* xd_net = (NetData*)ma->extra_data[GRAPH_NETLOAD];
+		key = g_strdup_printf("graph-%s-show-extended", graph_types[GRAPH_NETLOAD].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_net->show_extended);
+		g_free (key);
+		key = g_strdup_printf("graph-%s-show-per-iface", graph_types[GRAPH_NETLOAD].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_net->show_per_iface);
+		g_free (key);
+		key = g_strdup_printf("graph-%s-scale-link-speed", graph_types[GRAPH_NETLOAD].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_net->scale_link_speed);
+		g_free (key);
+
+		/* Swap graph */
+		SwapData* xd_swap = (SwapData*)ma->extra_data[GRAPH_SWAPLOAD];
+		key = g_strdup_printf("graph-%s-show-activity", graph_types[GRAPH_SWAPLOAD].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_swap->show_activity);
+		g_free (key);
+
+		/* Scheduler graph */
+		SchedData* xd_sched = (SchedData*)ma->extra_data[GRAPH_SCHED];
+		key = g_strdup_printf("graph-%s-show-softirqs", graph_types[GRAPH_SCHED].name);
+		multiload_ps_settings_get_boolean (settings, key, &xd_sched->show_softirqs);
+		g_free (key);
 
 		/* Parametric graph */
 		ParametricData* xd_parm = (ParametricData*)ma->extra_data[GRAPH_PARAMETRIC];
@@ -189,7 +228,12 @@ multiload_ui_save (MultiloadPlugin *ma)
 		multiload_ps_settings_set_int		(settings, "pref-dialog-width",		ma->pref_dialog_width);
 		multiload_ps_settings_set_int		(settings, "pref-dialog-height",	ma->pref_dialog_height);
 		multiload_ps_settings_set_boolean	(settings, "size-format-iec",		ma->size_format_iec);
+		multiload_ps_settings_set_int		(settings, "autoscaler-percentile",	ma->autoscaler_percentile);
+		multiload_ps_settings_set_int		(settings, "history-retention",		ma->history_retention);
+		multiload_ps_settings_set_boolean	(settings, "history-persist",		ma->history_persist);
+		multiload_ps_settings_set_boolean	(settings, "export-enabled",		ma->export_enabled);
 		multiload_ps_settings_set_string	(settings, "color-scheme",			ma->color_scheme);
+		multiload_ps_settings_set_string	(settings, "cgroup-scope",			ma->cgroup_scope);
 
 		/* Graph order */
 		key = int_array_to_string(ma->graph_order, GRAPH_MAX);
@@ -201,6 +245,36 @@ multiload_ui_save (MultiloadPlugin *ma)
 		key = g_strdup_printf("graph-%s-procps-compliant", graph_types[GRAPH_MEMLOAD].name);
 		multiload_ps_settings_set_boolean (settings, key, xd_mem->procps_compliant);
 		g_free (key);
+		key = g_strdup_printf("graph-%s-show-dirty", graph_types[GRAPH_MEMLOAD].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_mem->show_dirty);
+		g_free (key);
+		key = g_strdup_printf("graph-%s-show-hugepages", graph_types[GRAPH_MEMLOAD].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_mem->show_hugepages);
+		g_free (key);
+
+		/* Network graph */
+		NetData* xd_net = (NetData*)ma->extra_data[GRAPH_NETLOAD];
+		key = g_strdup_printf("graph-%s-show-extended", graph_types[GRAPH_NETLOAD].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_net->show_extended);
+		g_free (key);
+		key = g_strdup_printf("graph-%s-show-per-iface", graph_types[GRAPH_NETLOAD].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_net->show_per_iface);
+		g_free (key);
+		key = g_strdup_printf("graph-%s-scale-link-speed", graph_types[GRAPH_NETLOAD].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_net->scale_link_speed);
+		g_free (key);
+
+		/* Swap graph */
+		SwapData* xd_swap = (SwapData*)ma->extra_data[GRAPH_SWAPLOAD];
+		key = g_strdup_printf("graph-%s-show-activity", graph_types[GRAPH_SWAPLOAD].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_swap->show_activity);
+		g_free (key);
+
+		/* Scheduler graph */
+		SchedData* xd_sched = (SchedData*)ma->extra_data[GRAPH_SCHED];
+		key = g_strdup_printf("graph-%s-show-softirqs", graph_types[GRAPH_SCHED].name);
+		multiload_ps_settings_set_boolean (settings, key, xd_sched->show_softirqs);
+		g_free (key);
 
 		/* Parametric graph */
 		ParametricData* xd_parm = (ParametricData*)ma->extra_data[GRAPH_PARAMETRIC];
@@ -413,6 +487,7 @@ multiload_ui_parse_cmdline(int *argc, char ***argv, GOptionEntry *extra_entries)
 	g_option_context_add_group (context, gtk_get_option_group (TRUE));
 
 	g_option_context_add_main_entries (context, entries, GETTEXT_PACKAGE);
+	g_option_context_add_main_entries (context, multiload_profile_entries, GETTEXT_PACKAGE);
 	if (extra_entries != NULL)
 		g_option_context_add_main_entries (context, extra_entries, GETTEXT_PACKAGE);
 
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+#include <config.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "gtk-compat.h"
+#include "util-gtk.h"
+
+
+void show_modal_info_dialog(GtkWindow *parent, GtkMessageType type, const gchar *message)
+{
+	GtkWidget *dialog = gtk_message_dialog_new(parent,
+						GTK_DIALOG_MODAL | GTK_DIALOG_DESTROY_WITH_PARENT,
+						type, GTK_BUTTONS_CLOSE, "%s", message);
+	g_signal_connect (G_OBJECT (dialog), "response", (GCallback)gtk_widget_destroy, NULL);
+	gtk_widget_show(dialog);
+}
+
+
+/* Pixels of cairo surfaces are native endian 32 bit words (0xAARRGGBB) with
+ * premultiplied alpha, GdkPixbuf wants R, G, B, A bytes without premultiplied
+ * alpha. Opaque pixels (by far the most common in graphs) are just reordered,
+ * which is done a few pixels at a time where SIMD is available. */
+
+static inline void
+argb32_pixel_to_rgba (guint32 p, guchar *dest)
+{
+	guint a = p >> 24;
+
+	if (G_LIKELY(a == 0xff)) {
+		dest[0] = (p >> 16) & 0xff;
+		dest[1] = (p >> 8) & 0xff;
+		dest[2] = p & 0xff;
+	} else if (a == 0) {
+		dest[0] = dest[1] = dest[2] = 0;
+	} else {
+		dest[0] = (((p >> 16) & 0xff) * 0xff + a/2) / a;
+		dest[1] = (((p >> 8) & 0xff) * 0xff + a/2) / a;
+		dest[2] = ((p & 0xff) * 0xff + a/2) / a;
+	}
+	dest[3] = a;
+}
+
+static void
+argb32_row_to_rgba (const guint32 *src, guchar *dest, guint width, guint32 alpha_mask)
+{
+	guint i = 0;
+
+#if defined(__SSSE3__) && G_BYTE_ORDER == G_LITTLE_ENDIAN
+	const __m128i shuffle = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+	const __m128i opaque = _mm_set1_epi32(0xff000000);
+	const __m128i mask = _mm_set1_epi32(alpha_mask);
+
+	for (; i + 4 <= width; i += 4) {
+		__m128i v = _mm_or_si128(_mm_loadu_si128((const __m128i*)(src + i)), mask);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, opaque), opaque)) == 0xffff) {
+			_mm_storeu_si128((__m128i*)(dest + 4*i), _mm_shuffle_epi8(v, shuffle));
+		} else {
+			guint k;
+			for (k = i; k < i + 4; k++)
+				argb32_pixel_to_rgba(src[k] | alpha_mask, dest + 4*k);
+		}
+	}
+#elif defined(__ARM_NEON) && G_BYTE_ORDER == G_LITTLE_ENDIAN
+	const uint8x16_t mask = vdupq_n_u8(alpha_mask != 0 ? 0xff : 0);
+
+	for (; i + 16 <= width; i += 16) {
+		// channels are deinterleaved: B, G, R, A
+		uint8x16x4_t v = vld4q_u8((const uint8_t*)(src + i));
+		v.val[3] = vorrq_u8(v.val[3], mask);
+
+		uint8x8_t a = vand_u8(vget_low_u8(v.val[3]), vget_high_u8(v.val[3]));
+		if (vget_lane_u64(vreinterpret_u64_u8(a), 0) == G_GUINT64_CONSTANT(0xffffffffffffffff)) {
+			uint8x16_t b = v.val[0];
+			v.val[0] = v.val[2];
+			v.val[2] = b;
+			vst4q_u8(dest + 4*i, v);
+		} else {
+			guint k;
+			for (k = i; k < i + 16; k++)
+				argb32_pixel_to_rgba(src[k] | alpha_mask, dest + 4*k);
+		}
+	}
+#endif
+
+	for (; i < width; i++)
+		argb32_pixel_to_rgba(src[i] | alpha_mask, dest + 4*i);
+}
+
+/* Copies the top left part of an image surface (ARGB32 or RGB24) that fits
+ * into an existing RGBA pixbuf. Strides of both are honored. */
+void
+cairo_surface_copy_to_gdk_pixbuf(cairo_surface_t *surface, GdkPixbuf *pixbuf)
+{
+	cairo_format_t format = cairo_image_surface_get_format (surface);
+	guint width, height, y;
+	gint src_stride, dest_stride;
+	const guchar *src;
+	guchar *dest;
+
+	g_return_if_fail (format == CAIRO_FORMAT_ARGB32 || format == CAIRO_FORMAT_RGB24);
+	g_return_if_fail (gdk_pixbuf_get_has_alpha (pixbuf) && gdk_pixbuf_get_n_channels (pixbuf) == 4);
+
+	cairo_surface_flush (surface);
+
+	width = MIN(cairo_image_surface_get_width (surface), gdk_pixbuf_get_width (pixbuf));
+	height = MIN(cairo_image_surface_get_height (surface), gdk_pixbuf_get_height (pixbuf));
+	src = cairo_image_surface_get_data (surface);
+	src_stride = cairo_image_surface_get_stride (surface);
+	dest = gdk_pixbuf_get_pixels (pixbuf);
+	dest_stride = gdk_pixbuf_get_rowstride (pixbuf);
+
+	for (y = 0; y < height; y++)
+		argb32_row_to_rgba ((const guint32*)(src + y*src_stride), dest + y*dest_stride, width,
+				format == CAIRO_FORMAT_RGB24 ? 0xff000000 : 0);
+}
+
+/* Returns a new pixbuf, see multiload_pixbuf_pool_next to avoid allocations */
+GdkPixbuf*
+cairo_surface_to_gdk_pixbuf(cairo_surface_t *surface, guint width, guint height)
+{
+	GdkPixbuf *pixbuf = gdk_pixbuf_new (GDK_COLORSPACE_RGB, TRUE, 8, width, height);
+
+	cairo_surface_copy_to_gdk_pixbuf (surface, pixbuf);
+	return pixbuf;
+}
+
+/* Pool of two pixbufs, used in turn. Widgets may not notice changes to the
+ * pixels of a pixbuf they already show, so alternating makes each update a
+ * new image without allocating. A pixbuf still referenced by someone else is
+ * replaced rather than overwritten. */
+GdkPixbuf*
+multiload_pixbuf_pool_next (MultiloadPixbufPool *pool, guint width, guint height)
+{
+	GdkPixbuf *pixbuf;
+
+	pool->current = !pool->current;
+	pixbuf = pool->pixbuf[pool->current];
+
+	if (pixbuf != NULL && (G_OBJECT(pixbuf)->ref_count > 1 ||
+			(guint)gdk_pixbuf_get_width (pixbuf) != width || (guint)gdk_pixbuf_get_height (pixbuf) != height)) {
+		g_object_unref (pixbuf);
+		pixbuf = NULL;
+	}
+
+	if (pixbuf == NULL) {
+		pixbuf = gdk_pixbuf_new (GDK_COLORSPACE_RGB, TRUE, 8, width, height);
+		pool->pixbuf[pool->current] = pixbuf;
+	}
+
+	return pixbuf;
+}
+
+void
+multiload_pixbuf_pool_clear (MultiloadPixbufPool *pool)
+{
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS(pool->pixbuf); i++) {
+		if (pool->pixbuf[i] != NULL)
+			g_object_unref (pool->pixbuf[i]);
+		pool->pixbuf[i] = NULL;
+	}
+}
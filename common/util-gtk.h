@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef __UTIL_GTK_H__
+#define __UTIL_GTK_H__
+
+#include <gtk/gtk.h>
+
+
+G_BEGIN_DECLS
+
+// helpers that need GTK, util.h is also used by the collectors library
+
+// pixbufs recycled across updates, zero initialized
+typedef struct {
+	GdkPixbuf *pixbuf[2];
+	guint current;
+} MultiloadPixbufPool;
+
+G_GNUC_INTERNAL void
+show_modal_info_dialog(GtkWindow *parent, GtkMessageType type, const gchar *message);
+
+G_GNUC_INTERNAL GdkPixbuf*
+cairo_surface_to_gdk_pixbuf(cairo_surface_t *surface, guint width, guint height);
+G_GNUC_INTERNAL void
+cairo_surface_copy_to_gdk_pixbuf(cairo_surface_t *surface, GdkPixbuf *pixbuf);
+
+G_GNUC_INTERNAL GdkPixbuf*
+multiload_pixbuf_pool_next (MultiloadPixbufPool *pool, guint width, guint height);
+G_GNUC_INTERNAL void
+multiload_pixbuf_pool_clear (MultiloadPixbufPool *pool);
+
+G_END_DECLS
+
+#endif /* __UTIL_GTK_H__ */
@@ -25,7 +25,6 @@
 #include <stdio.h>
 #include <string.h>
 
-#include "gtk-compat.h"
 #include "util.h"
 
 
@@ -84,6 +83,21 @@ str_replace(const char *string , const char *needle , const char *replacement)
 	return newstr;
 }
 
+/* Appends formatted text to a fixed size, NULL terminated buffer */
+void
+str_append_printf(char *buf, size_t len, const char *format, ...)
+{
+	va_list args;
+	size_t n = strlen(buf);
+
+	if (n+1 >= len)
+		return;
+
+	va_start(args, format);
+	g_vsnprintf(buf+n, len-n, format, args);
+	va_end(args);
+}
+
 
 
 gchar*
@@ -183,16 +197,6 @@ format_time_duration(gdouble seconds) {
 }
 
 
-void show_modal_info_dialog(GtkWindow *parent, GtkMessageType type, const gchar *message)
-{
-	GtkWidget *dialog = gtk_message_dialog_new(parent,
-						GTK_DIALOG_MODAL | GTK_DIALOG_DESTROY_WITH_PARENT,
-						type, GTK_BUTTONS_CLOSE, "%s", message);
-	g_signal_connect (G_OBJECT (dialog), "response", (GCallback)gtk_widget_destroy, NULL);
-	gtk_widget_show(dialog);
-}
-
-
 gchar* get_system_monitor_executable()
 {
 	static const gchar* sysmon[] = {
@@ -239,30 +243,6 @@ xdg_open_url(const gchar* url)
 		g_warning (_("Unable to open the following url: '%s'"), url);
 }
 
-static void
-gdk_pixbuf_image_data_free (guchar *pixels, gpointer data)
-{
-	g_free(pixels);
-}
-
-GdkPixbuf*
-cairo_surface_to_gdk_pixbuf(cairo_surface_t *surface, guint width, guint height)
-{
-	guint i, j;
-	guchar *img_data, *img_data_converted;
-
-	img_data = cairo_image_surface_get_data (surface);
-	img_data_converted = g_new(guchar, width * height * 3);
-	for (i=0,j=0; i<width*height; i++) {
-		img_data_converted[j++] = img_data[i*4+2];
-		img_data_converted[j++] = img_data[i*4+1];
-		img_data_converted[j++] = img_data[i*4];
-	}
-
-	// create pixbuf from converted data
-	return gdk_pixbuf_new_from_data(img_data_converted, GDK_COLORSPACE_RGB, FALSE, 8, width, height, width*3, gdk_pixbuf_image_data_free, NULL);
-}
-
 gchar*
 int_array_to_string(const int *data, const int length)
 {
@@ -24,7 +24,6 @@
 
 #include <glib.h>
 #include <glib/gi18n-lib.h>
-#include <gtk/gtk.h>
 
 
 G_BEGIN_DECLS
@@ -33,6 +32,8 @@ G_GNUC_INTERNAL guint64
 calculate_speed(guint64 delta, guint period_ms);
 G_GNUC_INTERNAL char*
 str_replace(const char *string, const char *needle, const char *replacement);
+G_GNUC_INTERNAL void
+str_append_printf(char *buf, size_t len, const char *format, ...) G_GNUC_PRINTF(3, 4);
 
 G_GNUC_INTERNAL gchar*
 format_size_for_display (guint64 size, gboolean iec_units);
@@ -43,17 +44,11 @@ format_percent(guint64 value, guint64 total, guint ndigits);
 G_GNUC_INTERNAL gchar*
 format_time_duration(gdouble seconds);
 
-G_GNUC_INTERNAL void
-show_modal_info_dialog(GtkWindow *parent, GtkMessageType type, const gchar *message);
-
 G_GNUC_INTERNAL gchar*
 get_system_monitor_executable();
 G_GNUC_INTERNAL void
 xdg_open_url();
 
-G_GNUC_INTERNAL GdkPixbuf*
-cairo_surface_to_gdk_pixbuf(cairo_surface_t *surface, guint width, guint height);
-
 G_GNUC_INTERNAL gchar*
 int_array_to_string(const int *data, const int length);
 G_GNUC_INTERNAL void
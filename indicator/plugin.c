@@ -35,17 +35,28 @@
 #include "common/multiload-config.h"
 #include "common/preferences.h"
 #include "common/ui.h"
+#include "common/util-gtk.h"
 
 
 // Panel Specific Settings Implementation
 #define MULTILOAD_CONFIG_BASENAME "indicator.conf"
 #include "common/ps-settings-impl-gkeyfile.inc"
 
+// graph updates are collected for this many milliseconds, then shown together
+#define INDICATOR_FRAME_INTERVAL 100
+
 static AppIndicator *indicator;
 static GtkWidget *offscr;
 static gchar icon_directory[PATH_MAX];
 static gchar icon_filename[2][PATH_MAX];
 static int icon_current_index=0;
+static cairo_surface_t *icon_surface = NULL;
+static guchar *icon_last_data = NULL;
+static gsize icon_last_size = 0;
+static MultiloadPixbufPool icon_pixbufs;
+static cairo_rectangle_int_t icon_rects[GRAPH_MAX]; // where graphs are in icon_surface
+static gboolean graph_dirty[GRAPH_MAX];
+static guint frame_timer = 0;
 static gboolean indicator_connected;
 static GtkWidget *graphs_menu_items[GRAPH_MAX];
 
@@ -104,11 +115,11 @@ indicator_update_menu(MultiloadPlugin *ma)
 	gchar title[98], text[800], label[900];
 
 	for (i=0; i<GRAPH_MAX; i++) {
-		ma->graphs[i]->tooltip_update = ma->graph_config[i].visible;
+		ma->graphs[i]->collector->tooltip_update = ma->graph_config[i].visible;
 		gtk_widget_set_visible(graphs_menu_items[i], ma->graph_config[i].visible);
 
 		if (ma->graph_config[i].visible) {
-			graph_types[i].tooltip_update(title, sizeof(title), text, sizeof(text), ma->graphs[i], ma->extra_data[i], ma->graph_config[i].tooltip_style);
+			graph_types[i].tooltip_update(title, sizeof(title), text, sizeof(text), ma->graphs[i]->collector, ma->extra_data[i], ma->graph_config[i].tooltip_style);
 			g_snprintf(label, sizeof(label), "%s: %s", graph_types[i].label, text);
 			gtk_menu_item_set_label(GTK_MENU_ITEM(graphs_menu_items[i]), label);
 		}
@@ -116,31 +127,67 @@ indicator_update_menu(MultiloadPlugin *ma)
 	}
 }
 
-static void
-indicator_update_pixbuf(MultiloadPlugin *ma)
+/* Returns TRUE if composed icon differs from the one shown */
+static gboolean
+indicator_icon_changed(cairo_surface_t *surface)
 {
-	GtkAllocation allocation;
-	GError *error = NULL;
+	guchar *data;
+	gsize size;
 
-	cairo_status_t status;
-	cairo_surface_t *surface;
+	cairo_surface_flush (surface);
+	data = cairo_image_surface_get_data (surface);
+	size = cairo_image_surface_get_stride (surface) * cairo_image_surface_get_height (surface);
+
+	if (icon_last_data != NULL && size == icon_last_size && memcmp(data, icon_last_data, size) == 0)
+		return FALSE;
+
+	if (size != icon_last_size) {
+		icon_last_data = g_realloc (icon_last_data, size);
+		icon_last_size = size;
+	}
+	memcpy (icon_last_data, data, size);
+	return TRUE;
+}
+
+/* Copies graphs into the icon surface. The surface is kept across frames,
+ * so only graphs updated since last frame are copied, unless the layout
+ * changed. Returns FALSE if there is nothing to show. */
+static gboolean
+indicator_compose(MultiloadPlugin *ma)
+{
+	GtkAllocation allocation;
+	cairo_rectangle_int_t rect;
+	gboolean full = FALSE;
 	cairo_t *cr;
 
 	int i;
-	double x=ma->padding, y=ma->padding;
+	int x=ma->padding, y=ma->padding;
 
 	gtk_widget_get_allocation (GTK_WIDGET(ma->container), &allocation);
+	if (allocation.width < 1 || allocation.height < 1)
+		return FALSE;
+
+	if (icon_surface == NULL || cairo_image_surface_get_width (icon_surface) != allocation.width || cairo_image_surface_get_height (icon_surface) != allocation.height) {
+		if (icon_surface != NULL)
+			cairo_surface_destroy (icon_surface);
+		icon_surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, allocation.width, allocation.height);
+		full = TRUE;
+	}
+	g_assert (icon_surface != NULL);
 
-	surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, allocation.width, allocation.height);
-	g_assert (surface != NULL);
-	cr = cairo_create (surface);
-	cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
-
+	// any graph moved, resized or hidden: compose everything again
 	for (i=0; i<GRAPH_MAX; i++) {
-		if (ma->graph_config[i].visible) {
-			cairo_set_source_surface (cr, ma->graphs[i]->surface, x, y);
-			cairo_paint (cr);
+		rect.x = x;
+		rect.y = y;
+		rect.width = ma->graph_config[i].visible ? (int)ma->graphs[i]->draw_width : 0;
+		rect.height = ma->graph_config[i].visible ? (int)ma->graphs[i]->draw_height : 0;
+
+		if (memcmp(&rect, &icon_rects[i], sizeof(rect)) != 0) {
+			icon_rects[i] = rect;
+			full = TRUE;
+		}
 
+		if (ma->graph_config[i].visible) {
 			if (multiload_get_orientation(ma) == GTK_ORIENTATION_HORIZONTAL)
 				x += ma->graphs[i]->draw_width + ma->spacing;
 			else
@@ -148,45 +195,92 @@ indicator_update_pixbuf(MultiloadPlugin *ma)
 		}
 	}
 
-	status = cairo_surface_write_to_png (surface, icon_filename[icon_current_index]);
-	g_assert(status == CAIRO_STATUS_SUCCESS);
-	if (error != NULL) {
-		g_error("Cannot save Multiload-ng window to temporary buffer: %s\n", error->message);
+	cr = cairo_create (icon_surface);
+	cairo_set_antialias(cr, CAIRO_ANTIALIAS_NONE);
+
+	if (full) {
+		cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+		cairo_paint (cr);
+	}
+	cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+
+	for (i=0; i<GRAPH_MAX; i++) {
+		if (!ma->graph_config[i].visible || ma->graphs[i]->surface == NULL)
+			continue;
+		if (!full && !graph_dirty[i])
+			continue;
+
+		cairo_set_source_surface (cr, ma->graphs[i]->surface, icon_rects[i].x, icon_rects[i].y);
+		cairo_rectangle (cr, icon_rects[i].x, icon_rects[i].y, icon_rects[i].width, icon_rects[i].height);
+		cairo_fill (cr);
+	}
+
+	cairo_destroy (cr);
+	memset(graph_dirty, 0, sizeof(graph_dirty));
+	return TRUE;
+}
+
+/* Indicator hosts only take icons from files, so the icon is saved as an
+ * uncompressed PNG (cheaper to encode and to decode) in the runtime
+ * directory, that is usually in memory. Unchanged icons are not saved. */
+static void
+indicator_publish(void)
+{
+	GError *error = NULL;
+	GdkPixbuf *pixbuf;
+
+	if (!indicator_icon_changed(icon_surface))
+		return;
+
+	pixbuf = multiload_pixbuf_pool_next (&icon_pixbufs, cairo_image_surface_get_width (icon_surface), cairo_image_surface_get_height (icon_surface));
+	cairo_surface_copy_to_gdk_pixbuf (icon_surface, pixbuf);
+
+	if (!gdk_pixbuf_save (pixbuf, icon_filename[icon_current_index], "png", &error, "compression", "0", NULL)) {
+		g_warning("Cannot save Multiload-ng window to temporary buffer: %s", error->message);
 		g_clear_error(&error);
-	} else
+	} else {
 		app_indicator_set_icon(indicator, icon_filename[icon_current_index]);
+	}
 
 	icon_current_index = 1-icon_current_index;
-	cairo_surface_destroy (surface);
-	cairo_destroy (cr);
 }
 
-static void
-indicator_graph_update_cb(LoadGraph *g, gpointer user_data)
+/* All graphs updated within a frame interval are shown together */
+static gboolean
+indicator_frame_cb(MultiloadPlugin *ma)
 {
 	GtkAllocation allocation;
 
-	indicator_update_menu(g->multiload);
+	frame_timer = 0;
 
-	if (!g->config->visible)
-		return;
-
-	g_return_if_fail (g->surface != NULL);
+	indicator_update_menu(ma);
 
 	if (indicator_connected == FALSE) {
 		g_warning ("Indicator is not connected to panel, thus it cannot be displayed.");
-		return;
+		return FALSE;
 	}
 
 	// resize widget and offscreen window to fit into panel
-	if (multiload_get_orientation(g->multiload) == GTK_ORIENTATION_HORIZONTAL)
-		gtk_widget_set_size_request(GTK_WIDGET(g->multiload->container), multiload_calculate_size_request(g->multiload), indicator_get_icon_height());
+	if (multiload_get_orientation(ma) == GTK_ORIENTATION_HORIZONTAL)
+		gtk_widget_set_size_request(GTK_WIDGET(ma->container), multiload_calculate_size_request(ma), indicator_get_icon_height());
 	else
-		gtk_widget_set_size_request(GTK_WIDGET(g->multiload->container), 120, indicator_get_icon_height()); //TODO 120 should not be hardcoded
-	gtk_widget_get_allocation (GTK_WIDGET(g->multiload->container), &allocation);
+		gtk_widget_set_size_request(GTK_WIDGET(ma->container), 120, indicator_get_icon_height()); //TODO 120 should not be hardcoded
+	gtk_widget_get_allocation (GTK_WIDGET(ma->container), &allocation);
 	gtk_window_resize(GTK_WINDOW(offscr), allocation.width, allocation.height);
 
-	indicator_update_pixbuf(g->multiload);
+	if (indicator_compose(ma))
+		indicator_publish();
+
+	return FALSE; // single shot timer
+}
+
+static void
+indicator_graph_update_cb(LoadGraph *g, gpointer user_data)
+{
+	graph_dirty[g->id] = TRUE;
+
+	if (frame_timer == 0)
+		frame_timer = g_timeout_add (INDICATOR_FRAME_INTERVAL, (GSourceFunc)indicator_frame_cb, g->multiload);
 }
 
 static void
@@ -213,7 +307,12 @@ create_buffer_files()
 {
 	gchar *tmp;
 
-	gchar *template = g_build_filename(g_get_tmp_dir(), "multiload-ng.XXXXXX", NULL);
+	// runtime directory is a tmpfs on most systems, icons are not written to disk
+	const gchar *parent = g_get_user_runtime_dir();
+	if (parent == NULL || !g_file_test(parent, G_FILE_TEST_IS_DIR))
+		parent = g_get_tmp_dir();
+
+	gchar *template = g_build_filename(parent, "multiload-ng.XXXXXX", NULL);
 	char *dirname = mkdtemp(template);
 
 	if (dirname == NULL) {
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+#include <config.h>
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib-unix.h>
+
+#include "common/load-graph.h"
+#include "common/multiload-config.h"
+#include "common/multiload.h"
+#include "common/preferences.h"
+#include "common/ui.h"
+#include "headless.h"
+
+
+/* Headless mode runs the samplers of visible graphs (as configured in the
+ * graphical mode) without any display, and prints their values (the same
+ * of %1..%4 in command lines) at a fixed interval. */
+
+typedef enum {
+	HEADLESS_FORMAT_CSV,
+	HEADLESS_FORMAT_LINE,	// InfluxDB line protocol
+} HeadlessFormat;
+
+static gboolean opt_headless = FALSE;
+static gchar *opt_format = NULL;
+static gchar *opt_output = NULL;
+static gint opt_interval = 1000;
+static gint opt_count = 0;
+static gboolean opt_reset = FALSE;
+
+GOptionEntry standalone_headless_entries[] = {
+	{ "headless",	0,	 0, G_OPTION_ARG_NONE,		&opt_headless,	"Run without display, printing values of visible graphs", NULL },
+	{ "format",		0,	 0, G_OPTION_ARG_STRING,	&opt_format,	"Headless output format: csv (default) or line (InfluxDB line protocol)", "FORMAT" },
+	{ "output",		'o', 0, G_OPTION_ARG_FILENAME,	&opt_output,	"Headless output file (default: standard output)", "FILE" },
+	{ "interval",	'i', 0, G_OPTION_ARG_INT,		&opt_interval,	"Headless sampling interval in milliseconds (default: 1000)", "MS" },
+	{ "count",		'c', 0, G_OPTION_ARG_INT,		&opt_count,		"Headless mode exits after this many samples (default: never)", "N" },
+	{ NULL }
+};
+
+typedef struct {
+	MultiloadPlugin *ma;
+	LoadGraphColumn *column[GRAPH_MAX];	// NULL for hidden graphs
+	HeadlessFormat format;
+	FILE *out;
+	gint count;
+	GMainLoop *loop;
+} Headless;
+
+
+gboolean
+standalone_headless_requested (int argc, char *argv[])
+{
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--headless") == 0)
+			return TRUE;
+		if (strcmp(argv[i], "--") == 0)
+			break;
+	}
+	return FALSE;
+}
+
+static void
+standalone_headless_write_header (Headless *h)
+{
+	guint i, j;
+
+	if (h->format != HEADLESS_FORMAT_CSV)
+		return;
+
+	fputs("time", h->out);
+	for (i = 0; i < GRAPH_MAX; i++) {
+		if (h->column[i] == NULL)
+			continue;
+		for (j = 0; j < G_N_ELEMENTS(h->ma->graphs[i]->collector->output_str); j++)
+			fprintf(h->out, ",%s.%u", graph_types[i].name, j+1);
+	}
+	fputc('\n', h->out);
+}
+
+// CSV fields are quoted only when needed
+static void
+standalone_headless_write_csv_field (FILE *out, const gchar *value)
+{
+	const gchar *p;
+
+	if (strpbrk(value, ",\"\n") == NULL) {
+		fprintf(out, ",%s", value);
+		return;
+	}
+
+	fputs(",\"", out);
+	for (p = value; *p != '\0'; p++) {
+		if (*p == '"')
+			fputc('"', out);
+		fputc(*p, out);
+	}
+	fputc('"', out);
+}
+
+// numbers are written as floats, anything else as a string field
+static void
+standalone_headless_write_line_field (FILE *out, guint index, const gchar *value)
+{
+	const gchar *p;
+	gchar *endptr;
+
+	fprintf(out, "%sv%u=", index == 0 ? " " : ",", index+1);
+
+	g_ascii_strtod(value, &endptr);
+	if (value[0] != '\0' && *endptr == '\0') {
+		fputs(value, out);
+		return;
+	}
+
+	fputc('"', out);
+	for (p = value; *p != '\0'; p++) {
+		if (*p == '"' || *p == '\\')
+			fputc('\\', out);
+		fputc(*p, out);
+	}
+	fputc('"', out);
+}
+
+static gboolean
+standalone_headless_sample_cb (Headless *h)
+{
+	gint64 now = g_get_real_time();
+	guint i, j;
+
+	if (h->format == HEADLESS_FORMAT_CSV)
+		fprintf(h->out, "%"G_GINT64_FORMAT".%03d", now / G_USEC_PER_SEC, (gint)(now % G_USEC_PER_SEC / 1000));
+
+	for (i = 0; i < GRAPH_MAX; i++) {
+		LoadGraph *g = h->ma->graphs[i];
+		if (h->column[i] == NULL)
+			continue;
+
+		load_graph_collect(g, h->column[i]);
+		graph_types[i].cmdline_output(g->collector, g->collector->data);
+
+		if (h->format == HEADLESS_FORMAT_LINE)
+			fprintf(h->out, "multiload,graph=%s", graph_types[i].name);
+		for (j = 0; j < G_N_ELEMENTS(g->collector->output_str); j++) {
+			if (h->format == HEADLESS_FORMAT_CSV)
+				standalone_headless_write_csv_field(h->out, g->collector->output_str[j]);
+			else
+				standalone_headless_write_line_field(h->out, j, g->collector->output_str[j]);
+		}
+		if (h->format == HEADLESS_FORMAT_LINE)
+			fprintf(h->out, " %"G_GINT64_FORMAT"000\n", now);
+	}
+
+	if (h->format == HEADLESS_FORMAT_CSV)
+		fputc('\n', h->out);
+
+	if (fflush(h->out) != 0) {
+		g_printerr("Unable to write output: %s\n", g_strerror(errno));
+		g_main_loop_quit(h->loop);
+		return FALSE;
+	}
+
+	if (opt_count > 0 && ++h->count >= opt_count) {
+		g_main_loop_quit(h->loop);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+standalone_headless_signal_cb (Headless *h)
+{
+	g_main_loop_quit(h->loop);
+	return FALSE;
+}
+
+int
+standalone_headless_main (int argc, char *argv[])
+{
+	GOptionEntry extra_entries[] = {
+		{ "reset",	'r', 0, G_OPTION_ARG_NONE, &opt_reset, "Use default settings instead of saved ones", NULL },
+		{ NULL }
+	};
+	GOptionContext *context;
+	GError *error = NULL;
+	Headless h;
+	guint i, n = 0;
+
+	memset(&h, 0, sizeof(h));
+
+	// GTK option group is not added, as it would require a display
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Modern graphical system monitor (headless mode)");
+	g_option_context_add_main_entries (context, standalone_headless_entries, NULL);
+	g_option_context_add_main_entries (context, extra_entries, NULL);
+	g_option_context_add_main_entries (context, multiload_profile_entries, NULL);
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_printerr ("%s\n", error->message);
+		g_error_free (error);
+		return 1;
+	}
+	g_option_context_free (context);
+
+	if (opt_format == NULL || strcmp(opt_format, "csv") == 0) {
+		h.format = HEADLESS_FORMAT_CSV;
+	} else if (strcmp(opt_format, "line") == 0) {
+		h.format = HEADLESS_FORMAT_LINE;
+	} else {
+		g_printerr ("Unknown output format '%s'\n", opt_format);
+		return 1;
+	}
+	opt_interval = CLAMP(opt_interval, MIN_INTERVAL, MAX_INTERVAL);
+
+	if (opt_output == NULL || strcmp(opt_output, "-") == 0) {
+		h.out = stdout;
+	} else {
+		h.out = fopen(opt_output, "a");
+		if (h.out == NULL) {
+			g_printerr ("Unable to open '%s': %s\n", opt_output, g_strerror(errno));
+			return 1;
+		}
+	}
+
+	h.ma = multiload_new_full(TRUE);
+	if (opt_reset)
+		multiload_defaults (h.ma);
+	else
+		multiload_ui_read (h.ma);
+
+	for (i = 0; i < GRAPH_MAX; i++) {
+		if (!h.ma->graph_config[i].visible)
+			continue;
+		// rates are computed over the graph interval
+		h.ma->graph_config[i].interval = opt_interval;
+		h.column[i] = load_graph_column_new(h.ma->graphs[i]);
+		n++;
+	}
+	g_debug("[headless] Sampling %u graphs every %d ms", n, opt_interval);
+
+	// first sample only initializes counters of differential graphs
+	for (i = 0; i < GRAPH_MAX; i++) {
+		if (h.column[i] != NULL)
+			load_graph_collect(h.ma->graphs[i], h.column[i]);
+	}
+
+	standalone_headless_write_header(&h);
+	multiload_start_profile_dump(h.ma);
+
+	h.loop = g_main_loop_new (NULL, FALSE);
+	g_timeout_add (opt_interval, (GSourceFunc)standalone_headless_sample_cb, &h);
+	g_unix_signal_add (SIGINT, (GSourceFunc)standalone_headless_signal_cb, &h);
+	g_unix_signal_add (SIGTERM, (GSourceFunc)standalone_headless_signal_cb, &h);
+	g_main_loop_run (h.loop);
+	g_main_loop_unref (h.loop);
+
+	for (i = 0; i < GRAPH_MAX; i++)
+		g_free (h.column[i]);
+	multiload_free (h.ma);
+
+	if (h.out != stdout)
+		fclose (h.out);
+
+	return 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2016 Mario Cianciolo <mr.udda@gmail.com>
+ *
+ * This file is part of multiload-ng.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+
+
+
+#ifndef __STANDALONE_HEADLESS_H__
+#define __STANDALONE_HEADLESS_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+// shown in --help of the graphical mode too
+extern GOptionEntry standalone_headless_entries[];
+
+gboolean
+standalone_headless_requested (int argc, char *argv[]);
+int
+standalone_headless_main (int argc, char *argv[]);
+
+G_END_DECLS
+
+#endif /* __STANDALONE_HEADLESS_H__ */
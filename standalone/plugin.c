@@ -31,6 +31,7 @@
 #include "common/multiload.h"
 #include "common/preferences.h"
 #include "common/ui.h"
+#include "headless.h"
 
 
 // Panel Specific Settings Implementation
@@ -232,7 +233,11 @@ build_menu(MultiloadPlugin *ma, GtkWidget *button_config)
 }
 
 int main(int argc, char *argv[]) {
-	MultiloadOptions *options = multiload_ui_parse_cmdline (&argc, &argv, NULL);
+	// must be checked before GTK tries to open the display
+	if (standalone_headless_requested(argc, argv))
+		return standalone_headless_main(argc, argv);
+
+	MultiloadOptions *options = multiload_ui_parse_cmdline (&argc, &argv, standalone_headless_entries);
 	MultiloadPlugin *multiload = multiload_new();
 
 	if (options->reset_settings)
@@ -31,6 +31,7 @@
 #include "common/preferences.h"
 #include "common/ui.h"
 #include "common/util.h"
+#include "common/util-gtk.h"
 
 
 // Panel Specific Settings Implementation
@@ -44,6 +45,7 @@ G_GNUC_END_IGNORE_DEPRECATIONS
 static GtkWidget *offscr;
 static GtkWidget *menu;
 static guint timer_indexes[GRAPH_MAX];
+static MultiloadPixbufPool icon_pixbufs[GRAPH_MAX];
 
 static void
 systray_destroy_cb(GtkWidget *widget, MultiloadPlugin *ma)
@@ -80,8 +82,8 @@ systray_popup_menu (GtkStatusIcon *status_icon, guint button, guint activate_tim
 static void
 systray_graph_update_cb(LoadGraph *g, gpointer user_data)
 {
-	guint i, v;
-	gboolean visible;
+	static guint last_visible_mask = 0, last_icon_size = 0;
+	guint i, v, visible_mask;
 	GdkPixbuf *pixbuf;
 
 	if (!g->config->visible)
@@ -90,13 +92,20 @@ systray_graph_update_cb(LoadGraph *g, gpointer user_data)
 	g_return_if_fail (g->surface != NULL);
 	g_return_if_fail (status_icons[g->id] != NULL);
 
-	for (i=0, v=0; i<GRAPH_MAX; i++) {
-		visible = g->multiload->graph_config[i].visible;
-		G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-		gtk_status_icon_set_visible(status_icons[i], visible);
-		G_GNUC_END_IGNORE_DEPRECATIONS
-		if (visible)
+	for (i=0, v=0, visible_mask=0; i<GRAPH_MAX; i++) {
+		if (g->multiload->graph_config[i].visible) {
+			visible_mask |= 1 << i;
 			v++;
+		}
+	}
+
+	// layout is shared by all icons, it is only applied when it changes
+	if (visible_mask != last_visible_mask) {
+		for (i=0; i<GRAPH_MAX; i++) {
+			G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+			gtk_status_icon_set_visible(status_icons[i], (visible_mask & (1 << i)) != 0);
+			G_GNUC_END_IGNORE_DEPRECATIONS
+		}
 	}
 
 	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
@@ -104,8 +113,13 @@ systray_graph_update_cb(LoadGraph *g, gpointer user_data)
 	guint icon_size = gtk_status_icon_get_size(status_icons[g->id]);
 	G_GNUC_END_IGNORE_DEPRECATIONS
 
-	gtk_window_resize(GTK_WINDOW(offscr), v*icon_size, icon_size);
-	gtk_widget_set_size_request(GTK_WIDGET(g->multiload->container), v*icon_size, icon_size);
+	if (visible_mask != last_visible_mask || icon_size != last_icon_size) {
+		gtk_window_resize(GTK_WINDOW(offscr), v*icon_size, icon_size);
+		gtk_widget_set_size_request(GTK_WIDGET(g->multiload->container), v*icon_size, icon_size);
+
+		last_visible_mask = visible_mask;
+		last_icon_size = icon_size;
+	}
 
 	// set graph size from icon size
 	g->config->size = icon_size;
@@ -113,13 +127,13 @@ systray_graph_update_cb(LoadGraph *g, gpointer user_data)
 	if (g->draw_width != icon_size || g->draw_height != icon_size)
 		return; // incorrect pixbuf size - could be first drawing
 
-	pixbuf = cairo_surface_to_gdk_pixbuf(g->surface, icon_size, icon_size);
+	// pixbufs are owned by the pool and reused on next updates
+	pixbuf = multiload_pixbuf_pool_next(&icon_pixbufs[g->id], icon_size, icon_size);
+	cairo_surface_copy_to_gdk_pixbuf(g->surface, pixbuf);
 
 	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 	gtk_status_icon_set_from_pixbuf(status_icons[g->id], pixbuf);
 	G_GNUC_END_IGNORE_DEPRECATIONS
-
-	g_object_unref(pixbuf);
 }
 
 gboolean
@@ -129,7 +143,7 @@ systray_tooltip_disable (GtkStatusIcon *status_icon)
 
 	timer_indexes[g->id] = 0;
 
-	g->tooltip_update = FALSE;
+	g->collector->tooltip_update = FALSE;
 
 	G_GNUC_BEGIN_IGNORE_DEPRECATIONS
 	gtk_status_icon_set_tooltip_markup(status_icon, gtk_status_icon_get_title(status_icon));
@@ -141,7 +155,7 @@ systray_tooltip_disable (GtkStatusIcon *status_icon)
 gboolean
 systray_query_tooltip_cb (GtkStatusIcon *status_icon, gint x, gint y, gboolean keyboard_mode, GtkTooltip *tooltip, LoadGraph *g)
 {
-	g->tooltip_update = TRUE;
+	g->collector->tooltip_update = TRUE;
 
 	if (timer_indexes[g->id] > 0)
 		g_source_remove(timer_indexes[g->id]);
@@ -240,6 +254,7 @@ build_menu(MultiloadPlugin *ma)
 
 int main (int argc, char **argv)
 {
+	guint i;
 	MultiloadOptions *options = multiload_ui_parse_cmdline (&argc, &argv, NULL);
 	MultiloadPlugin *multiload = multiload_new();
 
@@ -270,5 +285,8 @@ int main (int argc, char **argv)
 
 	gtk_main ();
 
+	for (i = 0; i < GRAPH_MAX; i++)
+		multiload_pixbuf_pool_clear(&icon_pixbufs[i]);
+
 	return 0;
 }